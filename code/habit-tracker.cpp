@@ -10,6 +10,26 @@
 #include <iomanip>  
 #include <filesystem>
 #include <string> 
+#include <vector>
+#include <queue>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <cstdlib>
+#include <sys/wait.h>
+#include <sys/stat.h>
+#include <mutex>
+#include <deque>
+#include <unordered_map>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <tuple>
+#include <condition_variable>
+#include <fcntl.h>
+#include <sys/file.h>
 
 using std::to_string;
 
@@ -73,7 +93,7 @@ enum categories
     OTHER
 };
 
-// this struct defines habit
+// this struct defines a single habit as it is entered or read from a save, before it is stored in app_data
 struct habit
 {
     string name;
@@ -83,617 +103,2979 @@ struct habit
     bool* log;          // dynamic array
     int log_size;        // current size of the log
     int last_day_index;  // last day the habit was updated
+    int reminder_minute; // minutes past midnight to send a reminder, -1 for none
+
+    int id = -1;         // stable within the user's save so habits with the same name stay apart, -1 until assigned
 };
 
 // function to determine the day of the year 
 int get_today_index()
 {
     std::time_t t = std::time(nullptr);
-    std::tm* local_time = std::localtime(&t);
-    return local_time->tm_yday; 
+    std::tm local_time;
+    localtime_r(&t, &local_time); // reentrant so import workers can call it
+    return local_time.tm_yday; 
 }
 
-// this struct defines the application data
-struct app_data
+// function to convert a calendar date to the number of days since 1970-01-01
+int days_from_civil(int year, int month, int day)
 {
-    habit *habits = new habit[2];
-    user *users = new user[2];
-    int count = 0;
-    int size = 2;
-    int user_count = 0;
-    int user_size = 2;
-};
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int year_of_era = year - era * 400;
+    int day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
 
-// this function allows a user to create a new account 
-void sign_up(app_data &data, string &active_user)
+// function to determine today's date as the number of days since 1970-01-01
+int get_today_days()
 {
-    user new_user;
-    string password, confirm_password;
-
-    write_line("Please enter information to continue.");
+    std::time_t t = std::time(nullptr);
+    std::tm local_time;
+    localtime_r(&t, &local_time);
+    return days_from_civil(local_time.tm_year + 1900, local_time.tm_mon + 1, local_time.tm_mday);
+}
 
-    // loop until user enters valid username and password
-    do
+// function to convert a reminder time into HH:MM for display
+string reminder_to_string(int reminder_minute)
+{
+    if (reminder_minute < 0)
     {
-        new_user.correct_username = read_string("Choose a username: ");
+        return "None";
+    }
 
-        password = get_password("Choose a password: ");
-        confirm_password = get_password("Confirm your password: ");
+    std::stringstream ss;
+    ss << std::setw(2) << std::setfill('0') << reminder_minute / 60 << ":" << std::setw(2) << std::setfill('0') << reminder_minute % 60;
+    return ss.str();
+}
 
-        if (password == confirm_password)
+// function to read a reminder time as HH:MM, a blank entry means no reminder
+int read_reminder(const string &prompt)
+{
+    while (true)
+    {
+        string entry = read_string(prompt);
+        if (entry.empty())
         {
-            new_user.correct_password = hash_password(password);
-            active_user = new_user.correct_username;
-            break;
+            return -1;
         }
-        else
+
+        int hours, minutes;
+        char extra;
+        if (sscanf(entry.c_str(), "%d:%d%c", &hours, &minutes, &extra) == 2 && hours >= 0 && hours < 24 && minutes >= 0 && minutes < 60)
         {
-            write_line("Passwords do not match. Please try again.");
+            return hours * 60 + minutes;
         }
-        write_line();
-    } while (password != confirm_password);
+        write_line("Please enter a time such as 08:30, or leave it blank.");
+    }
+}
 
-    // add user name to the data
-    write("Enter your name: ");
-    new_user.user_name = read_line();
-    write_line("Welcome, " + new_user.user_name + "!");
+// the name pool holds up to NAME_CHUNKS chunks of NAME_CHUNK_SIZE names (16.7 million distinct names)
+const int NAME_CHUNK_BITS = 12;
+const int NAME_CHUNK_SIZE = 1 << NAME_CHUNK_BITS;
+const int NAME_CHUNKS = 4096;
 
-    // Add the new user to the array
-    if (data.user_count < data.user_size)
+// this struct interns habit names, names such as "Sleep" repeat across users and are stored once
+// names live in fixed size chunks that never move, so reading a name needs no lock
+struct name_pool
+{
+    std::atomic<string*> chunks[NAME_CHUNKS] = {};
+    int count = 0;
+    std::unordered_map<string, int> ids;
+    std::mutex mutex; // only taken while interning, import workers intern names concurrently
+};
+
+name_pool habit_names;
+
+// function to return the id of a habit name, adding it to the pool if it is new
+int intern_name(const string &name)
+{
+    std::lock_guard<std::mutex> lock(habit_names.mutex);
+    auto found = habit_names.ids.find(name);
+    if (found != habit_names.ids.end())
     {
-        data.users[data.user_count] = new_user;
-        data.user_count++;
+        return found->second;
     }
-    else
+
+    int id = habit_names.count;
+    if (id >> NAME_CHUNK_BITS >= NAME_CHUNKS)
     {
-        user *newArray = new user[data.user_size * 2];
-        for (int i = 0; i < data.user_count; i++)
-        {
-            newArray[i] = data.users[i];
-        }
-        delete[] data.users;
-        data.users = newArray;
-        data.user_size *= 2;
-        data.users[data.user_count] = new_user;
-        data.user_count++;
+        throw std::length_error("too many distinct habit names");
     }
 
-    // Save credentials to file
-    std::ofstream cred(credential_filename(new_user.correct_username));
-    cred << new_user.correct_username << "\n" << new_user.correct_password << "\n" << new_user.user_name << "\n";
-    cred.close();
+    string *chunk = habit_names.chunks[id >> NAME_CHUNK_BITS].load(std::memory_order_relaxed);
+    if (chunk == nullptr)
+    {
+        chunk = new string[NAME_CHUNK_SIZE];
+        habit_names.chunks[id >> NAME_CHUNK_BITS].store(chunk, std::memory_order_release);
+    }
+    chunk[id & (NAME_CHUNK_SIZE - 1)] = name;
+    habit_names.ids[name] = id;
+    habit_names.count++;
+    return id;
+}
 
-    // Create a save file for habit data
-    std::ofstream save(save_filename(new_user.correct_username));
-    save.close();
+// function to return the habit name for an interned id
+const string &habit_name(int id)
+{
+    return habit_names.chunks[id >> NAME_CHUNK_BITS].load(std::memory_order_acquire)[id & (NAME_CHUNK_SIZE - 1)];
 }
 
-// function to allow users to login 
-void login(app_data &data, string &active_user)
+// number of habits shown per category on the leaderboard
+const int LEADERBOARD_TOP_K = 5;
+
+// this struct defines one habit's place on the leaderboard, a streak of 0 means it is not on it
+struct board_entry
 {
-    string entered_username, entered_password;
+    string user_name;
+    int habit_id = 0; // with the user, identifies the habit on the leaderboard
+    string habit_name;
+    categories category = HEALTH;
+    int streak = 0;
+    int end_day = 0; // day of the last check-in in the streak, days since 1970-01-01
+};
 
-    write_line("Please log in to continue.");
+// this struct defines a habit's move on the leaderboard from the entry it last had to its live one
+struct board_change
+{
+    board_entry old_entry;
+    board_entry new_entry;
+};
 
-    // loop until a user exits or enters a correct username and password
-    while (true)
-    {
-        entered_username = read_string("Username: ");
-        entered_password = get_password("Password: ");
+// this struct collects leaderboard changes from many saves so a bulk tool can send them at once
+struct leaderboard_batch
+{
+    std::vector<board_change> changes;
+    std::mutex mutex;
+};
 
-        // open and read relevant file
-        std::ifstream cred(credential_filename(entered_username));
-        // if failed to open, inform user
-        if (!cred.is_open())
-        {
-            write_line("User not found. Please try again.");
-            continue;
-        }
+// this struct defines the application data, habits are stored as one array per field
+// so streak and report passes only pull the fields they use into cache
+struct app_data
+{
+    // fields read on every streak and report pass
+    int *current_streaks = new int[2];
+    int *targets = new int[2];
+    int *log_sizes = new int[2];
+    int *last_day_indexes = new int[2];
+    bool **logs = new bool*[2];
 
-        // retrieve information from the credentials file
-        string stored_username, stored_hash, stored_name;
-        getline(cred, stored_username);
-        getline(cred, stored_hash);
-        getline(cred, stored_name);
-        cred.close();
+    // fields only read when displaying or editing a habit
+    int *name_ids = new int[2];
+    categories *habit_categories = new categories[2];
+    int *reminder_minutes = new int[2];
 
-        // verify username and password 
-        if (entered_username == stored_username && hash_password(entered_password) == stored_hash)
-        {
-            write_line("Login successful! Welcome back, " + stored_username + "!");
-            active_user = stored_username;
-            break;
-        }
-        else
-        {
-            write_line("Invalid username or password. Please try again.");
-        }
+    int *habit_ids = new int[2];
 
-        // if user types exit, go back to login or signup page
-        if (entered_username == "exit" || entered_password == "exit")
-        {
-            write_line("Exiting.");
-            return;
-        }
-    }
+    user *users = new user[2];
+    int count = 0;
+    int size = 2;
+    int user_count = 0;
+    int user_size = 2;
+    int next_habit_id = 0;
+
+    // when set, leaderboard changes are collected here for the caller to send instead of on every save
+    leaderboard_batch *board_batch = nullptr;
+};
+
+// function to copy one habit field array into a new array of a different capacity
+template <typename T>
+void resize_field(T *&field, int count, int new_size)
+{
+    T *newArray = new T[new_size];
+    for (int i = 0; i < count; i++)
+        newArray[i] = field[i];
+    delete[] field;
+    field = newArray;
 }
 
-// this function converts a category enum to a string representation to display to the user
-string category_to_string(categories category)
+// this function changes the capacity of every habit field array
+void resize_habits(app_data &data, int new_size)
 {
-    switch (category)
-    {
-    case HEALTH:
-        return "Health";
-    case FITNESS:
-        return "Fitness";
-    case STUDY:
-        return "Study";
-    case HOBBY:
-        return "Hobby";
-    case OTHER:
-        return "Other";
-    default:
-        return "Unknown";
-    }
+    resize_field(data.current_streaks, data.count, new_size);
+    resize_field(data.targets, data.count, new_size);
+    resize_field(data.log_sizes, data.count, new_size);
+    resize_field(data.last_day_indexes, data.count, new_size);
+    resize_field(data.logs, data.count, new_size);
+    resize_field(data.name_ids, data.count, new_size);
+    resize_field(data.habit_categories, data.count, new_size);
+    resize_field(data.reminder_minutes, data.count, new_size);
+    resize_field(data.habit_ids, data.count, new_size);
+    data.size = new_size;
 }
 
-// increase size of log if needed
-void update_log_for_today(habit &h)
+// function to return the bytes one habit takes across the field arrays, kept beside resize_habits so both list every field
+size_t habit_bytes(const app_data &data)
 {
-    int today_index = get_today_index();
-    int days_passed = today_index - h.last_day_index;
+    return sizeof(*data.current_streaks) + sizeof(*data.targets) + sizeof(*data.log_sizes) + sizeof(*data.last_day_indexes) + sizeof(*data.logs)
+        + sizeof(*data.name_ids) + sizeof(*data.habit_categories) + sizeof(*data.reminder_minutes)
+        + sizeof(*data.habit_ids);
+}
 
-    // create new array, transfer data, delete old array
-    if (days_passed > 0)
+// this function appends a habit to the application data, doubling the arrays when full
+// the data takes ownership of the habit's log
+void append_habit(app_data &data, const habit &h)
+{
+    if (data.count == data.size)
     {
-        bool* newLog = new bool[h.log_size + days_passed];
-        for (int i = 0; i < h.log_size; i++)
-            newLog[i] = h.log[i];
-        for (int i = h.log_size; i < h.log_size + days_passed; i++)
-            newLog[i] = false;
-
-        delete[] h.log;
-        h.log = newLog;
-        h.log_size += days_passed;
-        h.last_day_index = today_index;
+        resize_habits(data, data.size * 2);
     }
+
+    int i = data.count;
+    data.current_streaks[i] = h.current_streak;
+    data.targets[i] = h.target;
+    data.log_sizes[i] = h.log_size;
+    data.last_day_indexes[i] = h.last_day_index;
+    data.logs[i] = h.log;
+    data.name_ids[i] = intern_name(h.name);
+    data.habit_categories[i] = h.category;
+    data.reminder_minutes[i] = h.reminder_minute;
+    data.habit_ids[i] = h.id >= 0 ? h.id : data.next_habit_id;
+    data.next_habit_id = std::max(data.next_habit_id, data.habit_ids[i] + 1);
+    data.count++;
 }
 
-// this function adds a new habit to the application data
-void add_habit(app_data &data)
+// number of habits kept per category in the leaderboard summary, so a few can fall off the top before it is rebuilt
+const int LEADERBOARD_TOP_DEPTH = 50;
+
+// this struct defines the leaderboard's counts and longest streaks for one category
+struct category_summary
 {
-    habit new_habit;
-    new_habit.name = read_string("Enter habit name: ");
-    new_habit.target = read_integer("Enter target (number of days): ");
+    std::map<std::pair<int, int>, int> streak_counts; // (streak, end day) to number of habits
+    std::vector<int> streak_tree;                      // Fenwick tree of habits per streak length, grown to fit the longest streak
+    int total = 0;
+    std::vector<board_entry> top; // longest first, no habit left out has a longer streak than the last one
+};
 
-    write_line();
-    write_line("Select category:");
-    write_line("1: Health");
-    write_line("2: Fitness");
-    write_line("3: Study");
-    write_line("4: Hobby");
-    write_line("5: Other");
-    int category_choice = read_integer("Enter your choice: ", 1, 5);
-    new_habit.category = (categories)(category_choice - 1);
+// this struct defines the leaderboard summary, small enough to read on every save however many users there are
+struct leaderboard_summary
+{
+    category_summary boards[OTHER + 1];
+    long long lines = 0; // lines in the leaderboard file, including ones since replaced
+};
 
-    // Initialize dynamic log for tracking habit completion 
-    new_habit.log_size = 1;
-    new_habit.log = new bool[new_habit.log_size]{false};
-    new_habit.current_streak = 0;
-    new_habit.last_day_index = get_today_index();
+// function to return the file the leaderboard is kept in beside the saves, one line per change and the last one for a habit wins
+string leaderboard_filename()
+{
+    return "saves/leaderboard.board";
+}
+
+// function to return the file the leaderboard summary is kept in
+string leaderboard_summary_filename()
+{
+    return "saves/leaderboard.summary";
+}
 
-    // Add to data.habits (dynamic array management same as before)
-    if (data.count < data.size)
+// function to take the leaderboard lock shared by every process, returns the lock file to pass to unlock_leaderboard
+int lock_leaderboard(int operation)
+{
+    int fd = open("saves/leaderboard.lock", O_CREAT | O_RDWR, 0644);
+    if (fd >= 0)
     {
-        data.habits[data.count] = new_habit;
-        data.count++;
+        flock(fd, operation);
     }
-    else
+    return fd;
+}
+
+// function to release the leaderboard lock
+void unlock_leaderboard(int fd)
+{
+    if (fd >= 0)
     {
-        habit* newArray = new habit[data.size * 2];
-        for (int i = 0; i < data.size; i++)
-            newArray[i] = data.habits[i];
-        delete[] data.habits;
-        data.habits = newArray;
-        data.size *= 2;
-        data.habits[data.count] = new_habit;
-        data.count++;
+        flock(fd, LOCK_UN);
+        close(fd);
     }
-    
-    // confirm habit creation to user 
-    write_line("Habit added successfully!");
 }
 
-// this function removes a habit from the application data
-void remove_habit(app_data &data)
+// function to format one leaderboard entry as a line
+// the habit name goes last so it may contain commas
+string board_line(const board_entry &entry)
 {
-    // Check if there are any habits to remove
-    if (data.count == 0)
+    return entry.user_name + "," + to_string(entry.habit_id) + "," + to_string(entry.category) + "," + to_string(entry.streak) + "," + to_string(entry.end_day) + "," + entry.habit_name + "\n";
+}
+
+// function to read one leaderboard line, returns false if it is not a complete entry
+bool parse_board_line(const string &line, board_entry &entry)
+{
+    size_t first = line.find(',');
+    if (first == string::npos)
     {
-        write_line("No habits to remove.");
-        return;
+        return false;
     }
 
-    // Display current habits
-    write_line("Current Habits: ");
-    for (int i = 0; i < data.count; i++)
+    // user,habit id,category,streak,end day,habit name
+    int category, name_start = -1;
+    if (sscanf(line.c_str() + first, ",%d,%d,%d,%d,%n", &entry.habit_id, &category, &entry.streak, &entry.end_day, &name_start) != 4 || name_start < 0)
     {
-        write_line(to_string(i + 1) + ". " + data.habits[i].name);
+        return false;
     }
+    entry.user_name = line.substr(0, first);
+    entry.habit_name = line.substr(first + name_start);
+    entry.category = (categories)category;
+    return entry.category >= HEALTH && entry.category <= OTHER;
+}
 
-    // Get the index of the habit to remove from the user
-    int index = read_integer("Enter the index of the habit to remove: ") - 1;
+// function to order leaderboard entries, the longest streak comes first
+bool longer_streak(const board_entry &a, const board_entry &b)
+{
+    return std::tie(b.streak, a.user_name, a.habit_id) < std::tie(a.streak, b.user_name, b.habit_id);
+}
 
-    // Validate the index
-    if (index < 0 || index >= data.count)
+// function to take a habit out of a category's longest streaks
+void remove_from_top(category_summary &board, const board_entry &entry)
+{
+    for (size_t i = 0; i < board.top.size(); i++)
     {
-        write_line("Invalid index.");
-        return;
+        if (board.top[i].user_name == entry.user_name && board.top[i].habit_id == entry.habit_id)
+        {
+            board.top.erase(board.top.begin() + i);
+            return;
+        }
     }
+}
 
-    // free dynamic memory allocated to the habit's log before removal 
-    delete[] data.habits[index].log; 
+// function to refill a category's Fenwick tree from its counts, with room for streaks below size
+void fill_streak_tree(category_summary &board, int size)
+{
+    board.streak_tree.assign(size, 0);
+    for (const auto &count : board.streak_counts)
+    {
+        for (int i = count.first.first; i < size; i += i & -i)
+        {
+            board.streak_tree[i] += count.second;
+        }
+    }
+}
 
-    // Shift habits to remove the selected habit
-    for (int i = index; i < data.count - 1; i++)
+// function to add delta to the number of habits with the entry's streak, counts never go below 0
+void add_streak_count(category_summary &board, const board_entry &entry, int delta)
+{
+    int &count = board.streak_counts[std::make_pair(entry.streak, entry.end_day)];
+    delta = std::max(count + delta, 0) - count;
+    count += delta;
+    board.total += delta;
+    if (count == 0)
     {
-        data.habits[i] = data.habits[i + 1];
+        board.streak_counts.erase(std::make_pair(entry.streak, entry.end_day));
     }
-    data.count--;
 
-    if (data.count > 0 && data.count <= data.size / 4 && data.size > 2) // Resize the array if needed
+    // double the tree when a longer streak arrives, the refill already includes this change
+    int size = board.streak_tree.size();
+    if (entry.streak >= size)
     {
-        habit *newArray = new habit[data.size / 2];
-        for (int i = 0; i < data.count; i++)
+        size = std::max(size, 64);
+        while (size <= entry.streak)
         {
-            newArray[i] = data.habits[i];
+            size *= 2;
         }
-        delete[] data.habits;
-        data.habits = newArray;
-        data.size /= 2;
+        fill_streak_tree(board, size);
+        return;
+    }
+    for (int i = entry.streak; i < size; i += i & -i)
+    {
+        board.streak_tree[i] += delta;
     }
-
-    // Confirm removal to the user
-    write_line("Habit removed successfully!");
-
 }
 
-// this function recalculates the current streak of a habit based on its log
-void recalculate_streak(habit &h)
+// this function moves one habit on the summary from the entry it last had to its live one
+// a streak of 0 means not on the leaderboard, and streaks whose last check-in was before yesterday have already expired
+void apply_board_change(leaderboard_summary &summary, const board_change &change, int today_days)
 {
-    // ensures habits log is updated for the day
-    update_log_for_today(h);
+    const board_entry &old_entry = change.old_entry;
+    const board_entry &new_entry = change.new_entry;
 
-    int streak = 0;
+    if (old_entry.streak > 0 && old_entry.end_day >= today_days - 1)
+    {
+        add_streak_count(summary.boards[old_entry.category], old_entry, -1);
+        remove_from_top(summary.boards[old_entry.category], old_entry);
+    }
+    if (new_entry.streak <= 0)
+    {
+        return;
+    }
 
-    // count consecutive days completed starting from most recent day
-    for (int i = h.log_size - 1; i >= 0; i--)
+    category_summary &board = summary.boards[new_entry.category];
+    remove_from_top(board, new_entry);
+
+    // the entry belongs in the top list if every habit is already in it or it is at least as long as the last one there
+    bool complete = (int)board.top.size() >= board.total;
+    add_streak_count(board, new_entry, 1);
+    if (complete || (!board.top.empty() && new_entry.streak >= board.top.back().streak))
     {
-        if (h.log[i])
+        board.top.insert(std::upper_bound(board.top.begin(), board.top.end(), new_entry, longer_streak), new_entry);
+        if ((int)board.top.size() > LEADERBOARD_TOP_DEPTH)
         {
-            streak++; // increment for each consecutive day completed
-        }
-        else
-        {
-            break; // stop counting when missed day is encountered 
+            board.top.pop_back();
         }
     }
+}
 
-    h.current_streak = streak;
+// function to return a streak's rank in a category, 1 is the longest, ties share a rank
+int leaderboard_rank(const category_summary &board, int streak)
+{
+    int shorter_or_equal = 0;
+    for (int i = std::min(streak, (int)board.streak_tree.size() - 1); i > 0; i -= i & -i)
+    {
+        shorter_or_equal += board.streak_tree[i];
+    }
+    return board.total - shorter_or_equal + 1;
 }
 
-// this function generates a progress bar for a habit based on its current streak and target
-string progress_bar(const habit &h, int bar_width = 20)
+// this function reads the leaderboard summary, dropping streaks that have since been missed, returns false if there is none
+bool load_leaderboard_summary(leaderboard_summary &summary, int today_days)
 {
-    // Calculate progress as a fraction of the target
-    double progress = (double)h.current_streak / h.target;
-    if (progress > 1.0)
+    std::ifstream file(leaderboard_summary_filename());
+    if (!file.is_open())
     {
-        progress = 1.0; // Cap at 100%
+        return false;
     }
 
-    // Generate the progress bar string
-    int pos = static_cast<int>(bar_width * progress);
+    string line;
+    while (std::getline(file, line))
+    {
+        if (line.compare(0, 2, "L,") == 0)
+        {
+            summary.lines = std::atoll(line.c_str() + 2);
+        }
+        else if (line.compare(0, 2, "C,") == 0)
+        {
+            // counts are written as category,streak,end day,count
+            int category, streak, end_day, count;
+            if (sscanf(line.c_str() + 2, "%d,%d,%d,%d", &category, &streak, &end_day, &count) == 4 && category >= HEALTH && category <= OTHER && end_day >= today_days - 1)
+            {
+                summary.boards[category].streak_counts[std::make_pair(streak, end_day)] += count;
+                summary.boards[category].total += count;
+            }
+        }
+        else if (line.compare(0, 2, "T,") == 0)
+        {
+            board_entry entry;
+            if (parse_board_line(line.substr(2), entry) && entry.end_day >= today_days - 1)
+            {
+                summary.boards[entry.category].top.push_back(entry);
+            }
+        }
+    }
+
+    for (int c = HEALTH; c <= OTHER; c++)
+    {
+        int longest = summary.boards[c].streak_counts.empty() ? 0 : summary.boards[c].streak_counts.rbegin()->first.first;
+        fill_streak_tree(summary.boards[c], std::max(64, longest + 1));
+    }
+    return true;
+}
+
+// this function writes the leaderboard summary, the caller holds the leaderboard lock
+void write_leaderboard_summary(const leaderboard_summary &summary)
+{
+    string temp_filename = leaderboard_summary_filename() + ".tmp";
+    std::ofstream file(temp_filename);
+    if (!file.is_open())
+    {
+        write_line("Error opening file for saving the leaderboard.");
+        return;
+    }
+
+    file << "L," << summary.lines << "\n";
+    for (int c = HEALTH; c <= OTHER; c++)
+    {
+        for (const auto &count : summary.boards[c].streak_counts)
+        {
+            file << "C," << c << "," << count.first.first << "," << count.first.second << "," << count.second << "\n";
+        }
+        for (const board_entry &entry : summary.boards[c].top)
+        {
+            file << "T," << board_line(entry);
+        }
+    }
+    file.close();
+    std::filesystem::rename(temp_filename, leaderboard_summary_filename());
+}
+
+// this function compacts the leaderboard file to one line per live streak and rebuilds the summary from it
+// it reads every entry, so it only runs once the file holds mostly stale lines or a top list runs short
+void rebuild_leaderboard(leaderboard_summary &summary, int today_days)
+{
+    std::map<std::pair<string, int>, board_entry> entries;
+    std::ifstream file(leaderboard_filename());
+    string line;
+    while (std::getline(file, line))
+    {
+        board_entry entry;
+        if (parse_board_line(line, entry))
+        {
+            entries[std::make_pair(entry.user_name, entry.habit_id)] = entry;
+        }
+    }
+    file.close();
+
+    summary = leaderboard_summary();
+    string temp_filename = leaderboard_filename() + ".tmp";
+    std::ofstream board(temp_filename);
+    for (const auto &item : entries)
+    {
+        const board_entry &entry = item.second;
+        if (entry.streak <= 0 || entry.end_day < today_days - 1)
+        {
+            continue;
+        }
+        board << board_line(entry);
+        add_streak_count(summary.boards[entry.category], entry, 1);
+        summary.boards[entry.category].top.push_back(entry);
+        summary.lines++;
+    }
+    board.close();
+    std::filesystem::rename(temp_filename, leaderboard_filename());
+
+    for (int c = HEALTH; c <= OTHER; c++)
+    {
+        std::vector<board_entry> &top = summary.boards[c].top;
+        size_t depth = std::min(top.size(), (size_t)LEADERBOARD_TOP_DEPTH);
+        std::partial_sort(top.begin(), top.begin() + depth, top.end(), longer_streak);
+        top.resize(depth);
+    }
+    write_leaderboard_summary(summary);
+}
+
+// this function sends habits' leaderboard changes, appending them to the leaderboard file and updating the summary
+// only the changed habits are read or written unless the file is due to be compacted
+void commit_board_changes(const std::vector<board_change> &changes)
+{
+    if (changes.empty())
+    {
+        return;
+    }
+
+    int lock_fd = lock_leaderboard(LOCK_EX);
+    int today_days = get_today_days();
+    leaderboard_summary summary;
+    if (!load_leaderboard_summary(summary, today_days))
+    {
+        rebuild_leaderboard(summary, today_days);
+    }
+
+    std::fstream board(leaderboard_filename(), std::ios::in | std::ios::out | std::ios::app);
+    if (!board.is_open())
+    {
+        board.open(leaderboard_filename(), std::ios::out | std::ios::app);
+    }
+
+    // start on a fresh line if a crash left the last append unfinished
+    board.seekg(0, std::ios::end);
+    if (board.tellg() > 0)
+    {
+        board.seekg(-1, std::ios::end);
+        if (board.get() != '\n')
+        {
+            board << "\n";
+        }
+    }
+    board.clear();
+    for (const board_change &change : changes)
+    {
+        board << board_line(change.new_entry);
+        apply_board_change(summary, change, today_days);
+    }
+    board.close();
+    summary.lines += changes.size();
+
+    // rebuild once most lines are stale, or when a category shows fewer habits than it has
+    long long live = 0;
+    bool short_top = false;
+    for (int c = HEALTH; c <= OTHER; c++)
+    {
+        const category_summary &category = summary.boards[c];
+        live += category.total;
+        if ((int)category.top.size() < std::min(category.total, LEADERBOARD_TOP_K))
+        {
+            short_top = true;
+        }
+    }
+    if (short_top || (summary.lines > 2 * live && summary.lines > LEADERBOARD_TOP_DEPTH))
+    {
+        rebuild_leaderboard(summary, today_days);
+    }
+    else
+    {
+        write_leaderboard_summary(summary);
+    }
+    unlock_leaderboard(lock_fd);
+}
+
+// this struct defines one user's summary in the save manifest
+struct manifest_entry
+{
+    string user_name;
+    long long save_size;
+    int habit_count;
+    int last_modified_day; // days since 1970-01-01
+    int best_streak;       // longest current_streak across the user's habits
+    int total_streak;      // sum of current_streak across the user's habits
+    long long save_time;   // modification time of the save file in nanoseconds
+};
+
+// guards appends to the manifest, import workers save several users at once
+std::mutex manifest_mutex;
+
+// this struct counts the manifest's lines and the users it held when last counted, so it can be compacted once it holds mostly stale lines
+struct manifest_counts
+{
+    long long lines = 0;
+    long long users = 0;
+};
+
+// function to return the manifest file that summarises every save
+string manifest_filename()
+{
+    return "saves/index.manifest";
+}
+
+// function to read the size and modification time of a save file, returns false if it does not exist
+bool read_save_stat(const string &filename, manifest_entry &entry)
+{
+    struct stat info;
+    if (stat(filename.c_str(), &info) != 0)
+    {
+        return false;
+    }
+
+    std::tm local_time;
+    localtime_r(&info.st_mtim.tv_sec, &local_time);
+    entry.save_size = info.st_size;
+    entry.save_time = info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec;
+    entry.last_modified_day = days_from_civil(local_time.tm_year + 1900, local_time.tm_mon + 1, local_time.tm_mday);
+    return true;
+}
+
+// function to summarise a user's habits and save file for the manifest
+manifest_entry summarise_save(const app_data &data, const string &user_name)
+{
+    manifest_entry entry;
+    entry.user_name = user_name;
+    entry.habit_count = data.count;
+    entry.best_streak = 0;
+    entry.total_streak = 0;
+    for (int i = 0; i < data.count; i++)
+    {
+        entry.best_streak = std::max(entry.best_streak, data.current_streaks[i]);
+        entry.total_streak += data.current_streaks[i];
+    }
+
+    if (!read_save_stat(save_filename(user_name), entry))
+    {
+        entry.save_size = 0;
+        entry.save_time = 0;
+        entry.last_modified_day = 0;
+    }
+    return entry;
+}
+
+// function to format a manifest entry as one comma separated line
+string manifest_line(const manifest_entry &entry)
+{
+    return entry.user_name + "," + to_string(entry.save_size) + "," + to_string(entry.habit_count) + "," + to_string(entry.last_modified_day) + "," + to_string(entry.best_streak) + "," + to_string(entry.total_streak) + "," + to_string(entry.save_time) + "\n";
+}
+
+// function to parse one manifest line, returns false unless all 7 fields are present and numeric
+bool parse_manifest_line(const string &line, manifest_entry &entry)
+{
+    std::stringstream ss(line);
+    std::vector<string> fields;
+    string token;
+    while (std::getline(ss, token, ','))
+    {
+        fields.push_back(token);
+    }
+    if (fields.size() != 7 || fields[0].empty())
+    {
+        return false;
+    }
+
+    try
+    {
+        entry.user_name = fields[0];
+        entry.save_size = std::stoll(fields[1]);
+        entry.habit_count = std::stoi(fields[2]);
+        entry.last_modified_day = std::stoi(fields[3]);
+        entry.best_streak = std::stoi(fields[4]);
+        entry.total_streak = std::stoi(fields[5]);
+        entry.save_time = std::stoll(fields[6]);
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+    return true;
+}
+
+// function to read the manifest, keeping the latest entry for each user, optionally counting its lines
+std::map<string, manifest_entry> read_manifest(long long *line_count = nullptr)
+{
+    std::map<string, manifest_entry> entries;
+    std::ifstream manifest(manifest_filename());
+
+    string line;
+    long long lines = 0;
+    while (std::getline(manifest, line))
+    {
+        lines++;
+
+        // skip lines cut short by a crash part way through an append
+        manifest_entry entry;
+        if (parse_manifest_line(line, entry))
+        {
+            entries[entry.user_name] = entry;
+        }
+    }
+
+    if (line_count != nullptr)
+    {
+        *line_count = lines;
+    }
+    return entries;
+}
+
+// function to return the file the manifest counts are kept in, so an append does not have to read the manifest
+string manifest_counts_filename()
+{
+    return manifest_filename() + ".count";
+}
+
+// function to read the manifest counts, counting the manifest itself if they have not been written yet
+manifest_counts read_manifest_counts()
+{
+    manifest_counts counts;
+    std::ifstream file(manifest_counts_filename());
+    string line;
+    if (std::getline(file, line) && sscanf(line.c_str(), "%lld,%lld", &counts.lines, &counts.users) == 2)
+    {
+        return counts;
+    }
+
+    counts.users = read_manifest(&counts.lines).size();
+    return counts;
+}
+
+// function to write the manifest counts, the caller holds the manifest locks
+void write_manifest_counts(const manifest_counts &counts)
+{
+    string temp_filename = manifest_counts_filename() + ".tmp";
+    std::ofstream file(temp_filename);
+    file << counts.lines << "," << counts.users << "\n";
+    file.close();
+    std::filesystem::rename(temp_filename, manifest_counts_filename());
+}
+
+// function to take the manifest lock shared by every process, returns the lock file to pass to unlock_manifest
+int lock_manifest()
+{
+    int fd = open((manifest_filename() + ".lock").c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd >= 0)
+    {
+        flock(fd, LOCK_EX);
+    }
+    return fd;
+}
+
+// function to release the manifest lock
+void unlock_manifest(int fd)
+{
+    if (fd >= 0)
+    {
+        flock(fd, LOCK_UN);
+        close(fd);
+    }
+}
+
+// function to lock a user's save file against other sessions of the same user, returns the lock file to pass to unlock_save
+int lock_save(const string &filename)
+{
+    int fd = open(filename.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd >= 0)
+    {
+        flock(fd, LOCK_EX);
+    }
+    return fd;
+}
+
+// function to release a save file's lock
+void unlock_save(int fd)
+{
+    if (fd >= 0)
+    {
+        flock(fd, LOCK_UN);
+        close(fd);
+    }
+}
+
+// function to replace the manifest with one line per user, the caller holds the manifest locks
+void write_manifest(const std::map<string, manifest_entry> &entries)
+{
+    // write the compacted manifest beside the old one and swap it in
+    string temp_filename = manifest_filename() + ".tmp";
+    std::ofstream manifest(temp_filename);
+    for (const auto &entry : entries)
+    {
+        manifest << manifest_line(entry.second);
+    }
+    manifest.close();
+    std::filesystem::rename(temp_filename, manifest_filename());
+
+    manifest_counts counts;
+    counts.lines = counts.users = entries.size();
+    write_manifest_counts(counts);
+}
+
+// function to record a user's latest summary, entries are appended and the last one for a user wins
+// once the manifest holds more than twice as many lines as users it is compacted
+void append_manifest_entry(const manifest_entry &entry)
+{
+    std::lock_guard<std::mutex> lock(manifest_mutex);
+    int lock_fd = lock_manifest();
+    manifest_counts counts = read_manifest_counts();
+
+    std::fstream manifest(manifest_filename(), std::ios::in | std::ios::out | std::ios::app);
+    if (!manifest.is_open())
+    {
+        manifest.open(manifest_filename(), std::ios::out | std::ios::app);
+    }
+
+    // start on a fresh line if a crash left the last append unfinished
+    manifest.seekg(0, std::ios::end);
+    if (manifest.tellg() > 0)
+    {
+        manifest.seekg(-1, std::ios::end);
+        if (manifest.get() != '\n')
+        {
+            manifest << "\n";
+        }
+    }
+    manifest.clear();
+    manifest << manifest_line(entry);
+    manifest.close();
+
+    counts.lines++;
+
+    // new users are only counted when the manifest is read, so recount before compacting
+    // a recount that finds mostly new users waits until the line count doubles again
+    if (counts.lines > 2 * counts.users)
+    {
+        std::map<string, manifest_entry> entries = read_manifest(&counts.lines);
+        counts.users = entries.size();
+        if (counts.lines > 2 * counts.users)
+        {
+            write_manifest(entries);
+        }
+        else
+        {
+            write_manifest_counts(counts);
+        }
+    }
+    else
+    {
+        write_manifest_counts(counts);
+    }
+
+    unlock_manifest(lock_fd);
+}
+
+// function to write a new user's credentials file
+void write_credentials(const user &new_user)
+{
+    std::ofstream cred(credential_filename(new_user.correct_username));
+    cred << new_user.correct_username << "\n" << new_user.correct_password << "\n" << new_user.user_name << "\n";
+    cred.close();
+}
+
+// function to read a user's credentials file, returns false if the user does not exist
+bool read_credentials(const string &username, user &stored)
+{
+    std::ifstream cred(credential_filename(username));
+    if (!cred.is_open())
+    {
+        return false;
+    }
+
+    getline(cred, stored.correct_username);
+    getline(cred, stored.correct_password);
+    getline(cred, stored.user_name);
+    return true;
+}
+
+// this function allows a user to create a new account 
+void sign_up(app_data &data, string &active_user)
+{
+    user new_user;
+    string password, confirm_password;
+
+    write_line("Please enter information to continue.");
+
+    // loop until user enters valid username and password
+    do
+    {
+        new_user.correct_username = read_string("Choose a username: ");
+
+        password = get_password("Choose a password: ");
+        confirm_password = get_password("Confirm your password: ");
+
+        if (password == confirm_password)
+        {
+            new_user.correct_password = hash_password(password);
+            active_user = new_user.correct_username;
+            break;
+        }
+        else
+        {
+            write_line("Passwords do not match. Please try again.");
+        }
+        write_line();
+    } while (password != confirm_password);
+
+    // add user name to the data
+    write("Enter your name: ");
+    new_user.user_name = read_line();
+    write_line("Welcome, " + new_user.user_name + "!");
+
+    // Add the new user to the array
+    if (data.user_count < data.user_size)
+    {
+        data.users[data.user_count] = new_user;
+        data.user_count++;
+    }
+    else
+    {
+        user *newArray = new user[data.user_size * 2];
+        for (int i = 0; i < data.user_count; i++)
+        {
+            newArray[i] = data.users[i];
+        }
+        delete[] data.users;
+        data.users = newArray;
+        data.user_size *= 2;
+        data.users[data.user_count] = new_user;
+        data.user_count++;
+    }
+
+    // Save credentials and an empty save file
+    write_credentials(new_user);
+    std::ofstream save(save_filename(new_user.correct_username));
+    save.close();
+
+    // add the new user to the manifest, the account has no habits yet
+    append_manifest_entry(summarise_save(data, new_user.correct_username));
+}
+
+// function to allow users to login 
+void login(app_data &data, string &active_user)
+{
+    string entered_username, entered_password;
+
+    write_line("Please log in to continue.");
+
+    // loop until a user exits or enters a correct username and password
+    while (true)
+    {
+        entered_username = read_string("Username: ");
+        entered_password = get_password("Password: ");
+
+        // read relevant file, if it does not exist inform user
+        user stored;
+        if (!read_credentials(entered_username, stored))
+        {
+            write_line("User not found. Please try again.");
+            continue;
+        }
+
+        // verify username and password 
+        if (entered_username == stored.correct_username && hash_password(entered_password) == stored.correct_password)
+        {
+            write_line("Login successful! Welcome back, " + stored.correct_username + "!");
+            active_user = stored.correct_username;
+            break;
+        }
+        else
+        {
+            write_line("Invalid username or password. Please try again.");
+        }
+
+        // if user types exit, go back to login or signup page
+        if (entered_username == "exit" || entered_password == "exit")
+        {
+            write_line("Exiting.");
+            return;
+        }
+    }
+}
+
+// this function converts a category enum to a string representation to display to the user
+string category_to_string(categories category)
+{
+    switch (category)
+    {
+    case HEALTH:
+        return "Health";
+    case FITNESS:
+        return "Fitness";
+    case STUDY:
+        return "Study";
+    case HOBBY:
+        return "Hobby";
+    case OTHER:
+        return "Other";
+    default:
+        return "Unknown";
+    }
+}
+
+// increase size of log if needed, callers look up today's index once per pass rather than once per habit
+void update_log_for_today(app_data &data, int index, int today_index)
+{
+    int days_passed = today_index - data.last_day_indexes[index];
+
+    // create new array, transfer data, delete old array
+    if (days_passed > 0)
+    {
+        int log_size = data.log_sizes[index];
+        bool* newLog = new bool[log_size + days_passed];
+        for (int i = 0; i < log_size; i++)
+            newLog[i] = data.logs[index][i];
+        for (int i = log_size; i < log_size + days_passed; i++)
+            newLog[i] = false;
+
+        delete[] data.logs[index];
+        data.logs[index] = newLog;
+        data.log_sizes[index] += days_passed;
+        data.last_day_indexes[index] = today_index;
+    }
+}
+
+// this function adds a new habit to the application data
+void add_habit(app_data &data)
+{
+    habit new_habit;
+    new_habit.name = read_string("Enter habit name: ");
+    new_habit.target = read_integer("Enter target (number of days): ");
+
+    write_line();
+    write_line("Select category:");
+    write_line("1: Health");
+    write_line("2: Fitness");
+    write_line("3: Study");
+    write_line("4: Hobby");
+    write_line("5: Other");
+    int category_choice = read_integer("Enter your choice: ", 1, 5);
+    new_habit.category = (categories)(category_choice - 1);
+
+    write_line();
+    new_habit.reminder_minute = read_reminder("Enter reminder time (HH:MM, blank for none): ");
+
+    // Initialize dynamic log for tracking habit completion 
+    new_habit.log_size = 1;
+    new_habit.log = new bool[new_habit.log_size]{false};
+    new_habit.current_streak = 0;
+    new_habit.last_day_index = get_today_index();
+
+    // Add to the habit arrays
+    append_habit(data, new_habit);
+    
+    // confirm habit creation to user 
+    write_line("Habit added successfully!");
+}
+
+// this function removes a habit from the application data
+void remove_habit(app_data &data)
+{
+    // Check if there are any habits to remove
+    if (data.count == 0)
+    {
+        write_line("No habits to remove.");
+        return;
+    }
+
+    // Display current habits
+    write_line("Current Habits: ");
+    for (int i = 0; i < data.count; i++)
+    {
+        write_line(to_string(i + 1) + ". " + habit_name(data.name_ids[i]));
+    }
+
+    // Get the index of the habit to remove from the user
+    int index = read_integer("Enter the index of the habit to remove: ") - 1;
+
+    // Validate the index
+    if (index < 0 || index >= data.count)
+    {
+        write_line("Invalid index.");
+        return;
+    }
+
+    // free dynamic memory allocated to the habit's log before removal 
+    delete[] data.logs[index]; 
+
+    // Shift habits to remove the selected habit
+    for (int i = index; i < data.count - 1; i++)
+    {
+        data.current_streaks[i] = data.current_streaks[i + 1];
+        data.targets[i] = data.targets[i + 1];
+        data.log_sizes[i] = data.log_sizes[i + 1];
+        data.last_day_indexes[i] = data.last_day_indexes[i + 1];
+        data.logs[i] = data.logs[i + 1];
+        data.name_ids[i] = data.name_ids[i + 1];
+        data.habit_categories[i] = data.habit_categories[i + 1];
+        data.reminder_minutes[i] = data.reminder_minutes[i + 1];
+        data.habit_ids[i] = data.habit_ids[i + 1];
+    }
+    data.count--;
+
+    if (data.count > 0 && data.count <= data.size / 4 && data.size > 2) // Resize the arrays if needed
+    {
+        resize_habits(data, data.size / 2);
+    }
+
+    // Confirm removal to the user
+    write_line("Habit removed successfully!");
+
+}
+
+// this function recalculates the current streak of a habit based on its log
+void recalculate_streak(app_data &data, int index, int today_index)
+{
+    // ensures habits log is updated for the day
+    update_log_for_today(data, index, today_index);
+
+    const bool *log = data.logs[index];
+    int streak = 0;
+
+    // count consecutive days completed starting from most recent day
+    for (int i = data.log_sizes[index] - 1; i >= 0; i--)
+    {
+        if (log[i])
+        {
+            streak++; // increment for each consecutive day completed
+        }
+        else
+        {
+            break; // stop counting when missed day is encountered 
+        }
+    }
+
+    data.current_streaks[index] = streak;
+}
+
+// function to return a habit's live leaderboard entry
+// a streak stays live through today as long as yesterday was checked off
+board_entry live_board_entry(const app_data &data, int index, const string &user_name, int today_days)
+{
+    const bool *log = data.logs[index];
+    int last = data.log_sizes[index] - 1;
+
+    board_entry entry;
+    entry.user_name = user_name;
+    entry.habit_id = data.habit_ids[index];
+    entry.habit_name = habit_name(data.name_ids[index]);
+    entry.category = data.habit_categories[index];
+    entry.streak = data.current_streaks[index];
+    entry.end_day = today_days;
+
+    if (entry.streak == 0 && last > 0 && log[last - 1])
+    {
+        entry.end_day--;
+        for (int i = last - 1; i >= 0 && log[i]; i--)
+        {
+            entry.streak++;
+        }
+    }
+    return entry;
+}
+
+// this function reads the leaderboard entries last sent with a save, by habit id
+// they are the last four fields of each habit, saves written before habits had ids sent nothing that can be matched
+std::map<int, board_entry> read_sent_entries(const string &filename, const string &user_name)
+{
+    std::map<int, board_entry> sent;
+    std::ifstream file(filename);
+    string line;
+    while (std::getline(file, line))
+    {
+        // name,target,streak,category,log size,last day,log...,reminder,category,streak,end day,id
+        std::stringstream ss(line);
+        board_entry entry;
+        string token;
+        std::getline(ss, entry.habit_name, ',');
+        for (int f = 0; f < 4; f++)
+        {
+            std::getline(ss, token, ',');
+        }
+        long long fields = std::count(line.begin(), line.end(), ',') + 1;
+        if (fields != 11 + std::atoll(token.c_str()))
+        {
+            continue;
+        }
+
+        size_t pos = line.size();
+        for (int f = 0; f < 4; f++)
+        {
+            pos = line.rfind(',', pos - 1);
+        }
+        int category;
+        if (sscanf(line.c_str() + pos, ",%d,%d,%d,%d", &category, &entry.streak, &entry.end_day, &entry.habit_id) == 4 && entry.streak > 0 && category >= HEALTH && category <= OTHER)
+        {
+            entry.user_name = user_name;
+            entry.category = (categories)category;
+            sent[entry.habit_id] = entry;
+        }
+    }
+    return sent;
+}
+
+// this function lists the habits whose leaderboard entry differs from the one last sent, habits no longer in the data are taken off
+std::vector<board_change> board_changes(app_data &data, const string &user_name, std::map<int, board_entry> sent, int today_index, int today_days)
+{
+    std::vector<board_change> changes;
+    for (int i = 0; i < data.count; i++)
+    {
+        recalculate_streak(data, i, today_index);
+
+        board_change change;
+        change.new_entry = live_board_entry(data, i, user_name, today_days);
+        change.old_entry = change.new_entry;
+        change.old_entry.streak = 0;
+        auto found = sent.find(data.habit_ids[i]);
+        if (found != sent.end())
+        {
+            change.old_entry = found->second;
+            sent.erase(found);
+        }
+
+        // a renamed habit is sent again so the leaderboard shows its new name
+        const board_entry &old_entry = change.old_entry, &new_entry = change.new_entry;
+        if (old_entry.streak == 0 && new_entry.streak == 0)
+        {
+            continue;
+        }
+        if (old_entry.category == new_entry.category && old_entry.streak == new_entry.streak && old_entry.end_day == new_entry.end_day && old_entry.habit_name == new_entry.habit_name)
+        {
+            continue;
+        }
+        changes.push_back(change);
+    }
+
+    for (const auto &removed : sent)
+    {
+        board_change change;
+        change.old_entry = removed.second;
+        change.new_entry = removed.second;
+        change.new_entry.streak = 0;
+        changes.push_back(change);
+    }
+    return changes;
+}
+
+// this function generates a progress bar for a habit based on its current streak and target
+string progress_bar(const app_data &data, int index, int bar_width = 20)
+{
+    // Calculate progress as a fraction of the target
+    double progress = (double)data.current_streaks[index] / data.targets[index];
+    if (progress > 1.0)
+    {
+        progress = 1.0; // Cap at 100%
+    }
+
+    // Generate the progress bar string
+    int pos = static_cast<int>(bar_width * progress);
     string bar = "[";
     for (int i = 0; i < bar_width; i++)
     {
-        if (i < pos)
+        if (i < pos)
+        {
+            bar += "#";
+        }
+        else 
+        {
+            bar += "-";
+        }
+    }
+    bar += "] ";
+    int percent = static_cast<int>(progress * 100);
+    bar += to_string(percent) + "%";
+    
+    return bar;
+}
+
+// this function recalculates every streak and builds the report text for all habits
+string build_habit_report(app_data &data)
+{
+    string report = "Habit Report:\n";
+    int today_index = get_today_index();
+    for (int i = 0; i < data.count; i++)
+    {
+        recalculate_streak(data, i, today_index);
+
+        report += "Habit: " + habit_name(data.name_ids[i]) + ", Target: " + to_string(data.targets[i]) + ", Current Streak: " + to_string(data.current_streaks[i]) + ", Category: " + category_to_string(data.habit_categories[i]) + ", Reminder: " + reminder_to_string(data.reminder_minutes[i]) + "\n";
+        report += progress_bar(data, i) + "\n\n";
+    }
+    return report;
+}
+
+// this function generates a report of all habits in the application data
+void habit_report(app_data &data)
+{
+    // Check if there are any habits to report
+    if (data.count == 0)
+    {
+        write_line("No habits to report.");
+        return;
+    }
+
+    // Display the habit report
+    write(build_habit_report(data));
+}
+
+// this function marks a habit as complete for today and updates its streak
+void check_off_today(app_data &data, int index)
+{
+    int today_index = get_today_index();
+    update_log_for_today(data, index, today_index);         // grow log if needed
+    data.logs[index][data.log_sizes[index] - 1] = true;     // mark today as complete
+    recalculate_streak(data, index, today_index);
+}
+
+// this function checks off a habit for the current day and updates its streak
+// returns true if a habit was checked off
+bool check_habit(app_data &data)
+{
+    if (data.count == 0)
+    {
+        write_line("No habits to check.");
+        return false;
+    }
+
+    write_line("Current Habits:");
+    for (int i = 0; i < data.count; i++)
+    {
+        write_line(to_string(i + 1) + ". " + habit_name(data.name_ids[i]));
+    }
+
+    int index = read_integer("Enter the index of the habit to check off: ") - 1;
+    if (index < 0 || index >= data.count)
+    {
+        write_line("Invalid index.");
+        return false;
+    }
+
+    check_off_today(data, index);
+
+    // inform user that habit was checked off successfully 
+    write_line("Habit checked off successfully!");
+
+    if (data.current_streaks[index] >= data.targets[index])
+    {
+        write_line();
+        write_line("Congratulations! You've reached your target for the habit: " + habit_name(data.name_ids[index]));
+        write_line("After celebrating, consider setting a new target.");
+        data.targets[index] = read_integer("Enter new target (number of days): ");
+    }
+
+    if (data.current_streaks[index] == 365)
+    {
+        write_line();
+        write_line("Congratulations! You have completed this habit for one whole year!");
+        write_line("You have mastered displine!");
+    }
+    return true;
+}
+
+// functions to update name of a habit
+void update_name(app_data &data, int index)
+{
+    data.name_ids[index] = intern_name(read_string("Enter new habit name: "));
+    write_line("Habit name updated successfully!");
+}
+
+// function to update target of a habit
+void update_target(app_data &data, int index)
+{
+    data.targets[index] = read_integer("Enter new target (number of days): ");
+    write_line("Habit target updated successfully!");
+}
+
+// function to update category of a habit
+void update_category(app_data &data, int index)
+{
+    write_line("Select new category:");
+    write_line("1. Health");
+    write_line("2. Fitness");
+    write_line("3. Study");
+    write_line("4. Hobby");
+    write_line("5. Other");
+    int category_choice = read_integer("Enter your choice: ", 1, 5);
+    data.habit_categories[index] = (categories)(category_choice - 1);
+    write_line("Habit category updated successfully!");
+}
+
+// function to update reminder time of a habit
+void update_reminder(app_data &data, int index)
+{
+    data.reminder_minutes[index] = read_reminder("Enter new reminder time (HH:MM, blank for none): ");
+    write_line("Habit reminder updated successfully!");
+}
+
+// this function updates the details of a habit in the application data
+void update_habit(app_data &data)
+{
+    // Check if there are any habits to update
+    if (data.count == 0)
+    {
+        write_line("No habits to update.");
+        return;
+    }
+
+    // Display current habits
+    write_line("Current Habits: ");
+    for (int i = 0; i < data.count; i++)
+    {
+        write_line(to_string(i + 1) + ". " + habit_name(data.name_ids[i]));
+    }
+
+    // Get the index of the habit to update from the user
+    int index = read_integer("Enter the index of the habit to update: ") - 1;
+
+    // Validate the index
+    if (index < 0 || index >= data.count)
+    {
+        write_line("Invalid index.");
+        return;
+    }
+
+    // Display update options to the user
+    write_line("Select an Option to Update:");
+    write_line("1. Name");  
+    write_line("2. Target");
+    write_line("3. Category");
+    write_line("4. Reminder");
+    write_line("5. All");
+    write_line("6. Back to Main Menu");
+
+    // Get the user's choice and perform the corresponding update
+    int choice = read_integer("Enter your choice: ", 1, 6);
+    while (choice != 6)
+    {
+        switch (choice)
+        {
+        case 1:
+            update_name(data, index);
+            break;
+        case 2:
+            update_target(data, index);
+            break;
+        case 3:
+            update_category(data, index);
+            break;
+        case 4:
+            update_reminder(data, index);
+            break;
+        case 5:
+            update_name(data, index);
+            update_target(data, index);
+            update_category(data, index);
+            update_reminder(data, index);
+            break;
+        default:
+            write_line("Invalid choice. Please try again.");
+            break;
+        }
+        choice = read_integer("Enter your choice: ", 1, 6);
+    }
+    
+    // Confirm update to the user
+    write_line("Habits updated successfully!");
+}
+
+// this function shows the longest streaks in each category and where the user's habits rank
+// the user's unsaved changes are counted on the summary without being sent
+void leaderboard_report(app_data &data, const string &active_user)
+{
+    int today_index = get_today_index();
+    int today_days = get_today_days();
+    leaderboard_summary summary;
+    int lock_fd = lock_leaderboard(LOCK_SH);
+    load_leaderboard_summary(summary, today_days);
+    unlock_leaderboard(lock_fd);
+
+    std::map<int, board_entry> sent = read_sent_entries(save_filename(active_user), active_user);
+    for (const board_change &change : board_changes(data, active_user, sent, today_index, today_days))
+    {
+        apply_board_change(summary, change, today_days);
+    }
+
+    write_line("Leaderboard:");
+    for (int c = HEALTH; c <= OTHER; c++)
+    {
+        const category_summary &board = summary.boards[c];
+        if (board.top.empty())
+        {
+            continue;
+        }
+
+        write_line(category_to_string((categories)c) + ":");
+        for (int i = 0; i < (int)board.top.size() && i < LEADERBOARD_TOP_K; i++)
+        {
+            const board_entry &entry = board.top[i];
+            int rank = leaderboard_rank(board, entry.streak);
+            write_line("  " + to_string(rank) + ". " + entry.user_name + " - " + entry.habit_name + ": " + to_string(entry.streak) + " days");
+        }
+    }
+
+    write_line();
+    write_line("Your Habits:");
+    for (int i = 0; i < data.count; i++)
+    {
+        board_entry entry = live_board_entry(data, i, active_user, today_days);
+        if (entry.streak > 0)
+        {
+            const category_summary &board = summary.boards[entry.category];
+            int rank = leaderboard_rank(board, entry.streak);
+            write_line(entry.habit_name + ": ranked " + to_string(rank) + " of " + to_string(board.total) + " in " + category_to_string(entry.category) + " with " + to_string(entry.streak) + " days");
+        }
+        else
+        {
+            write_line(entry.habit_name + ": not ranked, check it off to start a streak");
+        }
+    }
+}
+
+// this function pauses the program until the user presses Enter
+void pause_for_user()
+{
+    write_line();
+    write_line("Press Enter to continue...");
+    read_line();
+}
+
+// function to save the habit data 
+void save_data(app_data &data, const std::string &filename)
+{   
+    // the save records what was sent to the leaderboard, so only changes since the last save are sent
+    // it is locked while it is read back and rewritten so two sessions of one user never send from the same entries
+    string user_name = std::filesystem::path(filename).stem().string();
+    int lock_fd = lock_save(filename);
+    std::map<int, board_entry> sent = read_sent_entries(filename, user_name);
+
+    // open file
+    std::ofstream file(filename);
+
+    // if file does not open, inform user of error
+    if (!file.is_open())
+    {
+        write_line("Error opening file for saving data.");
+        unlock_save(lock_fd);
+        return;
+    }
+
+    int today_index = get_today_index();
+    int today_days = get_today_days();
+    std::vector<board_change> changes = board_changes(data, user_name, sent, today_index, today_days);
+
+    // seperate fields with commas and save to file
+    for (int i = 0; i < data.count; i++)
+    {
+        file << habit_name(data.name_ids[i]) << "," << data.targets[i] << "," << data.current_streaks[i] << "," << data.habit_categories[i] << "," << data.log_sizes[i] << "," << data.last_day_indexes[i];
+        for (int j = 0; j < data.log_sizes[i]; j++)
+        {
+            file << "," << data.logs[i][j];
+        }
+        // reminder goes after the log so older save files still load
+        file << "," << data.reminder_minutes[i];
+        // then the leaderboard entry sent with this save and the habit's id
+        board_entry entry = live_board_entry(data, i, user_name, today_days);
+        file << "," << entry.category << "," << entry.streak << "," << entry.end_day << "," << data.habit_ids[i];
+        // seperate habits by line 
+        file << "\n";
+    }
+    file.close();
+
+    // keep the manifest in step with the save file
+    append_manifest_entry(summarise_save(data, user_name));
+
+    if (data.board_batch != nullptr)
+    {
+        std::lock_guard<std::mutex> lock(data.board_batch->mutex);
+        data.board_batch->changes.insert(data.board_batch->changes.end(), changes.begin(), changes.end());
+    }
+    else
+    {
+        commit_board_changes(changes);
+    }
+    unlock_save(lock_fd);
+}
+
+// this function reads and loads the data from a save file for a particular user
+void load_data(app_data &data, const std::string &filename)
+{
+    // open file
+    std::ifstream file(filename);
+
+    // if there is an error opening the file, inform user
+    if (!file.is_open())
+    {
+        write_line("Error opening file for loading data.");
+        return;
+    }
+
+    // read file line by line, each line representing one habit 
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::stringstream ss(line); // parse CSV format
+        habit h; // temporary habit to populate 
+        std::string token;
+
+        // read fiels in order 
+        std::getline(ss, h.name, ',');
+        std::getline(ss, token, ','); h.target = std::stoi(token);
+        std::getline(ss, token, ','); h.current_streak = std::stoi(token);
+        std::getline(ss, token, ','); h.category = (categories)std::stoi(token);
+        std::getline(ss, token, ','); h.log_size = std::stoi(token);
+        std::getline(ss, token, ','); h.last_day_index = std::stoi(token);
+
+        h.log = new bool[h.log_size];
+        for (int i = 0; i < h.log_size; i++)
+        {
+            std::getline(ss, token, ',');
+            h.log[i] = std::stoi(token);
+        }
+
+        // older save files have no reminder field
+        h.reminder_minute = -1;
+        if (std::getline(ss, token, ',') && !token.empty())
+        {
+            h.reminder_minute = std::stoi(token);
+        }
+
+        // the leaderboard entry last sent is read back by save_data, older save files have no id so one is assigned
+        if (std::getline(ss, token, ',') && !token.empty())
+        {
+            std::getline(ss, token, ',');
+            std::getline(ss, token, ',');
+            if (std::getline(ss, token, ',') && !token.empty())
+            {
+                h.id = std::stoi(token);
+            }
+        }
+
+        append_habit(data, h);
+    }
+}
+
+// function to handle application exit and data saving
+void exit_app(app_data &data, const string &active_user)
+{
+    if (!active_user.empty())
+    {
+        save_data(data, save_filename(active_user));
+        write_line("Data saved. Exiting application.");
+    }
+}
+
+void cleanup(app_data &data)
+{
+    for (int i = 0; i < data.count; i++)
+    {
+        delete[] data.logs[i];
+    }
+    delete[] data.current_streaks;
+    delete[] data.targets;
+    delete[] data.log_sizes;
+    delete[] data.last_day_indexes;
+    delete[] data.logs;
+    delete[] data.name_ids;
+    delete[] data.habit_categories;
+    delete[] data.reminder_minutes;
+    delete[] data.habit_ids;
+    delete[] data.users;
+}
+
+// this function brings the manifest up to date, only reloading saves whose modification time changed
+void rebuild_manifest()
+{
+    // hold the locks throughout so no append lands between the read and the swap
+    std::lock_guard<std::mutex> lock(manifest_mutex);
+    int lock_fd = lock_manifest();
+
+    std::map<string, manifest_entry> entries = read_manifest();
+    std::map<string, manifest_entry> current;
+
+    for (const auto &file : std::filesystem::directory_iterator("saves"))
+    {
+        if (file.path().extension() != ".save")
+        {
+            continue;
+        }
+
+        string user_name = file.path().stem().string();
+        manifest_entry stat_entry;
+        if (!read_save_stat(file.path().string(), stat_entry))
+        {
+            continue;
+        }
+
+        auto found = entries.find(user_name);
+        if (found != entries.end() && found->second.save_time == stat_entry.save_time && found->second.save_size == stat_entry.save_size)
+        {
+            current[user_name] = found->second;
+            continue;
+        }
+
+        app_data data;
+        load_data(data, file.path().string());
+        current[user_name] = summarise_save(data, user_name);
+        cleanup(data);
+    }
+
+    write_manifest(current);
+    unlock_manifest(lock_fd);
+}
+
+// this function prints an admin report of every account from the manifest alone
+void list_users()
+{
+    std::map<string, manifest_entry> entries = read_manifest();
+    if (entries.empty())
+    {
+        write_line("No users in the manifest. Run ./habit --rebuild-index first.");
+        return;
+    }
+
+    int today_days = get_today_days();
+    int total_habits = 0;
+    write_line("User Report:");
+    for (const auto &item : entries)
+    {
+        const manifest_entry &entry = item.second;
+        total_habits += entry.habit_count;
+        write_line("User: " + entry.user_name + ", Habits: " + to_string(entry.habit_count) + ", Best Streak: " + to_string(entry.best_streak) + ", Total Streak: " + to_string(entry.total_streak) + ", Save Size: " + to_string(entry.save_size) + " bytes, Last Saved: " + to_string(today_days - entry.last_modified_day) + " days ago");
+    }
+    write_line();
+    write_line(to_string(entries.size()) + " users, " + to_string(total_habits) + " habits.");
+}
+
+// number of check-in rows sorted in memory per run file during an import
+const int IMPORT_RUN_ROWS = 1 << 18;
+
+// check-ins before this year are rejected, which bounds how far back an imported log can reach
+const int IMPORT_MIN_YEAR = 1970;
+
+// target given to habits that only exist in imported history
+const int IMPORT_DEFAULT_TARGET = 30;
+
+// this struct defines one imported check-in
+struct import_row
+{
+    string user_name;
+    string habit_name;
+    int day; // days since 1970-01-01
+};
+
+// this function orders check-ins by user, then habit, then day
+bool import_row_less(const import_row &a, const import_row &b)
+{
+    if (a.user_name != b.user_name) return a.user_name < b.user_name;
+    if (a.habit_name != b.habit_name) return a.habit_name < b.habit_name;
+    return a.day < b.day;
+}
+
+// this struct lets the merge queue pop the smallest check-in first
+struct import_cursor_greater
+{
+    bool operator()(const std::pair<import_row, int> &a, const std::pair<import_row, int> &b) const
+    {
+        return import_row_less(b.first, a.first);
+    }
+};
+
+// function to split a "user,habit,value" line, habit names may not contain commas (same as save files)
+bool split_import_line(const string &line, import_row &row, string &value)
+{
+    size_t first = line.find(',');
+    size_t last = line.rfind(',');
+    if (first == string::npos || first == last || first == 0)
+    {
+        return false;
+    }
+
+    row.user_name = line.substr(0, first);
+    row.habit_name = line.substr(first + 1, last - first - 1);
+    value = line.substr(last + 1);
+    return !row.habit_name.empty() && !value.empty();
+}
+
+// function to parse a "user,habit,YYYY-MM-DD" row from an import file
+bool parse_import_row(const string &line, import_row &row)
+{
+    string date;
+    if (!split_import_line(line, row, date))
+    {
+        return false;
+    }
+
+    int year, month, day;
+    char extra;
+    if (sscanf(date.c_str(), "%d-%d-%d%c", &year, &month, &day, &extra) != 3 || year < IMPORT_MIN_YEAR || year > 9999 || month < 1 || month > 12)
+    {
+        return false;
+    }
+
+    // reject days past the end of the month, such as 2026-02-31
+    const int days_in_month[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap_year = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    if (day < 1 || day > days_in_month[month - 1] + (month == 2 && leap_year))
+    {
+        return false;
+    }
+
+    row.day = days_from_civil(year, month, day);
+    return true;
+}
+
+// function to sort one run of check-ins and write it to a temporary run file
+void write_import_run(std::vector<import_row> rows, const string &path)
+{
+    std::sort(rows.begin(), rows.end(), import_row_less);
+
+    std::ofstream run(path);
+    for (const import_row &row : rows)
+    {
+        run << row.user_name << "," << row.habit_name << "," << row.day << "\n";
+    }
+}
+
+// function to read the next check-in from a sorted run file
+bool read_import_run(std::ifstream &run, import_row &row)
+{
+    string line, day;
+    if (!std::getline(run, line) || !split_import_line(line, row, day))
+    {
+        return false;
+    }
+    row.day = std::stoi(day);
+    return true;
+}
+
+// this function finds a habit's index by name, adding it with default settings if the user does not have it yet
+int find_or_add_habit(app_data &data, const string &name)
+{
+    int name_id = intern_name(name);
+    for (int i = 0; i < data.count; i++)
+    {
+        if (data.name_ids[i] == name_id)
         {
-            bar += "#";
+            return i;
         }
-        else 
+    }
+
+    habit new_habit;
+    new_habit.name = name;
+    new_habit.target = IMPORT_DEFAULT_TARGET;
+    new_habit.category = OTHER;
+    new_habit.log_size = 1;
+    new_habit.log = new bool[new_habit.log_size]{false};
+    new_habit.current_streak = 0;
+    new_habit.last_day_index = get_today_index();
+    new_habit.reminder_minute = -1;
+    append_habit(data, new_habit);
+    return data.count - 1;
+}
+
+// this function merges one user's sorted check-ins into their save file, returns false if the account does not exist
+bool import_user_history(const string &user_name, const std::vector<import_row> &rows, int today_days, leaderboard_batch &batch)
+{
+    if (!std::filesystem::exists(credential_filename(user_name)))
+    {
+        return false;
+    }
+
+    app_data data;
+    if (std::filesystem::exists(save_filename(user_name)))
+    {
+        load_data(data, save_filename(user_name));
+    }
+    data.board_batch = &batch;
+    int today_index = get_today_index();
+
+    size_t start = 0;
+    while (start < rows.size())
+    {
+        // rows for one habit are contiguous and the oldest day comes first
+        size_t end = start;
+        while (end < rows.size() && rows[end].habit_name == rows[start].habit_name)
+        {
+            end++;
+        }
+
+        int index = find_or_add_habit(data, rows[start].habit_name);
+        update_log_for_today(data, index, today_index);
+
+        // grow the log backwards so that its first entry is the oldest imported day
+        int log_size = data.log_sizes[index];
+        int needed = today_days - rows[start].day + 1;
+        if (needed > log_size)
+        {
+            bool* newLog = new bool[needed]{false};
+            for (int i = 0; i < log_size; i++)
+                newLog[needed - log_size + i] = data.logs[index][i];
+
+            delete[] data.logs[index];
+            data.logs[index] = newLog;
+            data.log_sizes[index] = log_size = needed;
+        }
+
+        // the last log entry is today, so the next check-off lands on the right day even if the save was last touched in an earlier year
+        for (size_t i = start; i < end; i++)
+        {
+            data.logs[index][log_size - 1 - (today_days - rows[i].day)] = true;
+        }
+        data.last_day_indexes[index] = today_index;
+
+        recalculate_streak(data, index, today_index);
+        start = end;
+    }
+
+    save_data(data, save_filename(user_name));
+    cleanup(data);
+    return true;
+}
+
+// this struct defines the bounded queue of users waiting for an import worker
+struct import_queue
+{
+    std::deque<std::vector<import_row>> users;
+    size_t capacity;
+    bool closed = false;
+    std::mutex mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+};
+
+// function to hand a user's check-ins to the workers, waiting while the queue is full
+void import_queue_push(import_queue &queue, std::vector<import_row> rows)
+{
+    std::unique_lock<std::mutex> lock(queue.mutex);
+    queue.not_full.wait(lock, [&]() { return queue.users.size() < queue.capacity; });
+    queue.users.push_back(std::move(rows));
+    queue.not_empty.notify_one();
+}
+
+// function to take the next user's check-ins, returns false once the queue is closed and empty
+bool import_queue_pop(import_queue &queue, std::vector<import_row> &rows)
+{
+    std::unique_lock<std::mutex> lock(queue.mutex);
+    queue.not_empty.wait(lock, [&]() { return !queue.users.empty() || queue.closed; });
+    if (queue.users.empty())
+    {
+        return false;
+    }
+
+    rows = std::move(queue.users.front());
+    queue.users.pop_front();
+    queue.not_full.notify_one();
+    return true;
+}
+
+// function to tell the workers that no more users are coming
+void import_queue_close(import_queue &queue)
+{
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.closed = true;
+    queue.not_empty.notify_all();
+}
+
+// this function imports check-in history from a file of "user,habit,YYYY-MM-DD" rows
+void import_history(const string &filename)
+{
+    std::ifstream file(filename);
+    if (!file.is_open())
+    {
+        write_line("Error opening file for import.");
+        return;
+    }
+
+    size_t workers = std::max(1u, std::thread::hardware_concurrency());
+    int today_days = get_today_days();
+
+    std::filesystem::path run_dir = std::filesystem::temp_directory_path() / ("habit-import-" + to_string(getpid()));
+    std::filesystem::create_directories(run_dir);
+
+    // first pass: cut the input into sorted runs, at most one run in memory per core
+    std::vector<std::thread> sorters;
+    std::vector<string> run_paths;
+    std::vector<import_row> batch;
+    long long bad_rows = 0, future_rows = 0, total_rows = 0;
+
+    auto flush_batch = [&]()
+    {
+        if (sorters.size() == workers)
+        {
+            sorters.front().join();
+            sorters.erase(sorters.begin());
+        }
+        run_paths.push_back((run_dir / ("run" + to_string(run_paths.size()))).string());
+        sorters.emplace_back(write_import_run, std::move(batch), run_paths.back());
+        batch = std::vector<import_row>();
+    };
+
+    string line;
+    import_row row;
+    while (std::getline(file, line))
+    {
+        // files exported on Windows end each row with \r\n
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        if (!parse_import_row(line, row))
+        {
+            bad_rows++;
+            continue;
+        }
+        if (row.day > today_days)
+        {
+            future_rows++;
+            continue;
+        }
+
+        batch.push_back(row);
+        total_rows++;
+        if ((int)batch.size() == IMPORT_RUN_ROWS)
+        {
+            flush_batch();
+        }
+    }
+    if (!batch.empty())
+    {
+        flush_batch();
+    }
+    for (std::thread &sorter : sorters)
+    {
+        sorter.join();
+    }
+
+    // second pass: merge the runs and hand each user's check-ins to a worker
+    std::vector<std::ifstream> runs(run_paths.size());
+    std::priority_queue<std::pair<import_row, int>, std::vector<std::pair<import_row, int>>, import_cursor_greater> heads;
+    for (size_t i = 0; i < run_paths.size(); i++)
+    {
+        runs[i].open(run_paths[i]);
+        if (read_import_run(runs[i], row))
+        {
+            heads.push({row, (int)i});
+        }
+    }
+
+    std::atomic<int> imported_users(0), skipped_users(0);
+    leaderboard_batch board_batch;
+    std::vector<import_row> user_rows;
+
+    // a fixed pool of workers takes users from a bounded queue
+    import_queue queue;
+    queue.capacity = workers * 2;
+    std::vector<std::thread> importers;
+    for (size_t w = 0; w < workers; w++)
+    {
+        importers.emplace_back([&]()
+        {
+            std::vector<import_row> rows;
+            while (import_queue_pop(queue, rows))
+            {
+                if (import_user_history(rows.front().user_name, rows, today_days, board_batch))
+                    imported_users++;
+                else
+                    skipped_users++;
+            }
+        });
+    }
+
+    auto flush_user = [&]()
+    {
+        import_queue_push(queue, std::move(user_rows));
+        user_rows = std::vector<import_row>();
+    };
+
+    while (!heads.empty())
+    {
+        std::pair<import_row, int> head = heads.top();
+        heads.pop();
+
+        if (!user_rows.empty() && user_rows.back().user_name != head.first.user_name)
+        {
+            flush_user();
+        }
+        user_rows.push_back(head.first);
+
+        if (read_import_run(runs[head.second], row))
+        {
+            heads.push({row, head.second});
+        }
+    }
+    if (!user_rows.empty())
+    {
+        flush_user();
+    }
+    import_queue_close(queue);
+    for (std::thread &importer : importers)
+    {
+        importer.join();
+    }
+
+    // send every user's leaderboard changes at once rather than taking the lock per save
+    commit_board_changes(board_batch.changes);
+    runs.clear();
+    std::filesystem::remove_all(run_dir);
+
+    // report the outcome of the import to the user
+    write_line("Imported " + to_string(total_rows) + " check-ins for " + to_string(imported_users.load()) + " users.");
+    if (skipped_users > 0)
+        write_line("Skipped " + to_string(skipped_users.load()) + " users without an account.");
+    if (bad_rows > 0)
+        write_line("Skipped " + to_string(bad_rows) + " malformed rows.");
+    if (future_rows > 0)
+        write_line("Skipped " + to_string(future_rows) + " rows dated in the future.");
+}
+
+// the reminder wheel has 4 levels of 64 slots, level n slots are 64^n seconds wide
+const int WHEEL_BITS = 6;
+const int WHEEL_SLOTS = 1 << WHEEL_BITS;
+const int WHEEL_LEVELS = 4;
+
+// seconds between checks of the save files for check-ins and edits
+const int REMINDER_RESCAN_SECONDS = 30;
+
+// this struct defines a pending reminder, linked into one slot of the wheel
+struct wheel_timer
+{
+    long long expires; // time the reminder is due, in seconds
+    int prev;
+    int next;
+    int level;
+    int slot;
+    bool active;
+    string user_name;
+    string habit_name;
+    int habit_index;
+};
+
+// this struct defines a hierarchical timing wheel, timers live in a pool and are referenced by index
+struct timing_wheel
+{
+    long long now = 0;
+    std::vector<wheel_timer> timers;
+    std::vector<int> free_timers;
+    int heads[WHEEL_LEVELS][WHEEL_SLOTS];
+};
+
+// function to set up an empty wheel starting at the given time
+void wheel_init(timing_wheel &wheel, long long now)
+{
+    wheel.now = now;
+    wheel.timers.clear();
+    wheel.free_timers.clear();
+    for (int level = 0; level < WHEEL_LEVELS; level++)
+        for (int slot = 0; slot < WHEEL_SLOTS; slot++)
+            wheel.heads[level][slot] = -1;
+}
+
+// function to link a timer into the slot matching its expiry
+void wheel_link(timing_wheel &wheel, int id)
+{
+    wheel_timer &t = wheel.timers[id];
+
+    // pick the finest level whose slot can still tell the expiry apart from now
+    int level = 0;
+    while (level < WHEEL_LEVELS - 1 && (t.expires >> (WHEEL_BITS * level)) - (wheel.now >> (WHEEL_BITS * level)) >= WHEEL_SLOTS)
+    {
+        level++;
+    }
+
+    long long slot_time = t.expires >> (WHEEL_BITS * level);
+    long long latest = (wheel.now >> (WHEEL_BITS * level)) + WHEEL_SLOTS - 1;
+    if (slot_time > latest)
+    {
+        slot_time = latest; // beyond the wheel, cascaded again when reached
+    }
+
+    t.level = level;
+    t.slot = slot_time & (WHEEL_SLOTS - 1);
+    t.prev = -1;
+    t.next = wheel.heads[level][t.slot];
+    if (t.next != -1)
+    {
+        wheel.timers[t.next].prev = id;
+    }
+    wheel.heads[level][t.slot] = id;
+}
+
+// function to unlink a timer from its slot
+void wheel_unlink(timing_wheel &wheel, int id)
+{
+    wheel_timer &t = wheel.timers[id];
+    if (t.prev != -1)
+        wheel.timers[t.prev].next = t.next;
+    else
+        wheel.heads[t.level][t.slot] = t.next;
+    if (t.next != -1)
+        wheel.timers[t.next].prev = t.prev;
+}
+
+// function to add a reminder to the wheel, returns its id for cancelling
+int wheel_insert(timing_wheel &wheel, long long expires, const string &user_name, const string &habit_name, int habit_index)
+{
+    int id;
+    if (!wheel.free_timers.empty())
+    {
+        id = wheel.free_timers.back();
+        wheel.free_timers.pop_back();
+    }
+    else
+    {
+        id = wheel.timers.size();
+        wheel.timers.push_back(wheel_timer());
+    }
+
+    // overdue reminders fire on the next tick
+    wheel_timer &t = wheel.timers[id];
+    t.expires = std::max(expires, wheel.now + 1);
+    t.active = true;
+    t.user_name = user_name;
+    t.habit_name = habit_name;
+    t.habit_index = habit_index;
+    wheel_link(wheel, id);
+    return id;
+}
+
+// function to remove a pending reminder from the wheel
+void wheel_cancel(timing_wheel &wheel, int id)
+{
+    if (id < 0 || id >= (int)wheel.timers.size() || !wheel.timers[id].active)
+    {
+        return;
+    }
+    wheel_unlink(wheel, id);
+    wheel.timers[id].active = false;
+    wheel.free_timers.push_back(id);
+}
+
+// function to move the wheel forward one second, due timers are added to fired and released
+void wheel_tick(timing_wheel &wheel, std::vector<wheel_timer> &fired)
+{
+    wheel.now++;
+
+    // when a level wraps, spread the next slot of the level above into finer slots
+    for (int level = 1; level < WHEEL_LEVELS; level++)
+    {
+        if ((wheel.now & ((1LL << (WHEEL_BITS * level)) - 1)) != 0)
+        {
+            break;
+        }
+
+        int slot = (wheel.now >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1);
+        int id = wheel.heads[level][slot];
+        wheel.heads[level][slot] = -1;
+        while (id != -1)
+        {
+            int next = wheel.timers[id].next;
+            wheel_link(wheel, id);
+            id = next;
+        }
+    }
+
+    int slot = wheel.now & (WHEEL_SLOTS - 1);
+    int id = wheel.heads[0][slot];
+    wheel.heads[0][slot] = -1;
+    while (id != -1)
+    {
+        int next = wheel.timers[id].next;
+        fired.push_back(wheel.timers[id]);
+        wheel.timers[id].active = false;
+        wheel.free_timers.push_back(id);
+        id = next;
+    }
+}
+
+// this struct tracks the reminders scheduled for one user
+struct reminder_user
+{
+    std::filesystem::file_time_type save_time;
+    std::map<int, int> pending;                 // habit index to timer id, names may repeat
+    std::set<std::pair<int, string>> sent_today; // habit index and name
+};
+
+// function to send a reminder to the log, and to a notification program if one is set in HABIT_REMINDER_HOOK
+void notify_reminder(const wheel_timer &reminder)
+{
+    string message = "Reminder for " + reminder.user_name + ": you have not checked off " + reminder.habit_name + " today.";
+    write_line(message);
+
+    std::time_t t = std::time(nullptr);
+    std::tm local_time;
+    localtime_r(&t, &local_time);
+    std::ofstream log("reminders.log", std::ios::app);
+    log << std::put_time(&local_time, "%Y-%m-%d %H:%M:%S") << " " << message << "\n";
+
+    // run the hook directly rather than through a shell so habit names are passed as plain arguments
+    const char *hook = std::getenv("HABIT_REMINDER_HOOK");
+    if (hook != nullptr && fork() == 0)
+    {
+        execlp(hook, hook, reminder.user_name.c_str(), reminder.habit_name.c_str(), (char *)nullptr);
+        _exit(127);
+    }
+}
+
+// function to determine the time of the most recent local midnight, in seconds
+long long get_midnight_time()
+{
+    std::time_t t = std::time(nullptr);
+    std::tm local_time;
+    localtime_r(&t, &local_time);
+    local_time.tm_hour = 0;
+    local_time.tm_min = 0;
+    local_time.tm_sec = 0;
+    return std::mktime(&local_time);
+}
+
+// this function reloads a user's save and reschedules their reminders, skipping habits already checked off today
+void schedule_user_reminders(timing_wheel &wheel, reminder_user &state, const string &user_name, long long midnight)
+{
+    for (const auto &pending : state.pending)
+    {
+        wheel_cancel(wheel, pending.second);
+    }
+    state.pending.clear();
+
+    app_data data;
+    load_data(data, save_filename(user_name));
+    int today_index = get_today_index();
+    for (int i = 0; i < data.count; i++)
+    {
+        const string &name = habit_name(data.name_ids[i]);
+        if (data.reminder_minutes[i] < 0 || state.sent_today.count(std::make_pair(i, name)))
+        {
+            continue;
+        }
+
+        update_log_for_today(data, i, today_index);
+        if (data.logs[i][data.log_sizes[i] - 1])
+        {
+            continue; // already done today
+        }
+
+        state.pending[i] = wheel_insert(wheel, midnight + data.reminder_minutes[i] * 60LL, user_name, name, i);
+    }
+    cleanup(data);
+}
+
+// this function runs the reminder scheduler for every user under saves/ until the program is stopped
+void run_reminders()
+{
+    timing_wheel wheel;
+    std::map<string, reminder_user> users;
+    long long midnight = get_midnight_time();
+    long long last_scan = 0;
+    std::vector<wheel_timer> fired;
+
+    wheel_init(wheel, std::time(nullptr));
+    write_line("Reminder scheduler running. Press Ctrl+C to stop.");
+
+    while (true)
+    {
+        // a new day starts every reminder again
+        long long today_midnight = get_midnight_time();
+        if (today_midnight != midnight)
+        {
+            midnight = today_midnight;
+            wheel_init(wheel, std::time(nullptr));
+            users.clear();
+            last_scan = 0;
+        }
+
+        // pick up new check-ins and edits from changed save files
+        if (wheel.now - last_scan >= REMINDER_RESCAN_SECONDS)
+        {
+            last_scan = wheel.now;
+            std::set<string> seen;
+            for (const auto &entry : std::filesystem::directory_iterator("saves"))
+            {
+                if (entry.path().extension() != ".save")
+                {
+                    continue;
+                }
+
+                string user_name = entry.path().stem().string();
+                std::filesystem::file_time_type save_time = entry.last_write_time();
+                seen.insert(user_name);
+
+                auto found = users.find(user_name);
+                if (found == users.end() || found->second.save_time != save_time)
+                {
+                    reminder_user &state = users[user_name];
+                    state.save_time = save_time;
+                    schedule_user_reminders(wheel, state, user_name, midnight);
+                }
+            }
+
+            // cancel reminders for deleted saves
+            for (auto it = users.begin(); it != users.end();)
+            {
+                if (seen.count(it->first))
+                {
+                    ++it;
+                    continue;
+                }
+                for (const auto &pending : it->second.pending)
+                {
+                    wheel_cancel(wheel, pending.second);
+                }
+                it = users.erase(it);
+            }
+        }
+
+        // catch the wheel up to the clock and send whatever is due
+        long long now = std::time(nullptr);
+        while (wheel.now < now)
+        {
+            wheel_tick(wheel, fired);
+        }
+        for (const wheel_timer &reminder : fired)
+        {
+            reminder_user &state = users[reminder.user_name];
+            state.pending.erase(reminder.habit_index);
+            state.sent_today.insert(std::make_pair(reminder.habit_index, reminder.habit_name));
+            notify_reminder(reminder);
+        }
+        fired.clear();
+
+        // reap finished notification hooks
+        while (waitpid(-1, nullptr, WNOHANG) > 0)
         {
-            bar += "-";
         }
+
+        sleep(1);
     }
-    bar += "] ";
-    int percent = static_cast<int>(progress * 100);
-    bar += to_string(percent) + "%";
-    
-    return bar;
 }
 
-// this function generates a report of all habits in the application data
-void habit_report(const app_data &data)
+// generated accounts are named with this prefix and a number, their password is the prefix plus the name
+const string LOADGEN_PREFIX = "load";
+
+// common habit names, earlier names are picked more often
+const string LOADGEN_HABITS[] = {"Sleep", "Eat", "Drink Water", "Run", "Read", "Gym", "Flashcards", "Make Bed", "Meditate", "Walk", "Play Guitar", "Journal", "Stretch", "Cook", "Study"};
+const int LOADGEN_HABIT_COUNT = sizeof(LOADGEN_HABITS) / sizeof(LOADGEN_HABITS[0]);
+
+// a user's chance of being picked for a session falls off as 1 / rank ^ LOADGEN_USER_SKEW
+const double LOADGEN_USER_SKEW = 1.0;
+
+// users hashing to the same one of these locks take turns loading and saving their save files
+const int LOADGEN_USER_LOCKS = 256;
+
+// the operations a replayed session can perform
+enum session_op
 {
-    // Check if there are any habits to report
-    if (data.count == 0)
-    {
-        write_line("No habits to report.");
-        return;
-    }
+    OP_LOGIN,
+    OP_CHECK,
+    OP_REPORT,
+    OP_EXIT,
+    OP_COUNT
+};
 
-    // Display the habit report
-    write_line("Habit Report:");
-    for (int i = 0; i < data.count; i++)
-    {
-        recalculate_streak(data.habits[i]);
+// this struct defines one step of a replayed session
+struct session_step
+{
+    session_op op;
+    int habit_index; // habit to check off, wraps around the user's habit count
+};
 
-        const habit &h = data.habits[i];
-        write_line("Habit: " + h.name + ", Target: " + to_string(h.target) + ", Current Streak: " + to_string(h.current_streak) + ", Category: " + category_to_string(h.category));
-        write_line(progress_bar(h));
-        write_line();
-    }
-}
+// this struct defines one replayed session for a user
+struct session
+{
+    string user_name;
+    std::vector<session_step> steps;
+};
 
-// this function checks off a habit for the current day and updates its streak
-void check_habit(app_data &data)
+// function to return the name of a session operation
+string session_op_to_string(session_op op)
 {
-    if (data.count == 0)
+    switch (op)
     {
-        write_line("No habits to check.");
-        return;
+    case OP_LOGIN:
+        return "login";
+    case OP_CHECK:
+        return "check";
+    case OP_REPORT:
+        return "report";
+    case OP_EXIT:
+        return "exit";
+    default:
+        return "unknown";
     }
+}
 
-    write_line("Current Habits:");
-    for (int i = 0; i < data.count; i++)
-    {
-        write_line(to_string(i + 1) + ". " + data.habits[i].name);
-    }
+// function to return the name of the nth generated user
+string loadgen_username(int number)
+{
+    std::stringstream ss;
+    ss << LOADGEN_PREFIX << std::setw(6) << std::setfill('0') << number;
+    return ss.str();
+}
 
-    int index = read_integer("Enter the index of the habit to check off: ") - 1;
-    if (index < 0 || index >= data.count)
-    {
-        write_line("Invalid index.");
-        return;
-    }
+// function to write one generated user through the same credential and save formats as sign_up and save_data
+void generate_user(int number, unsigned long long seed, leaderboard_batch &batch)
+{
+    std::mt19937_64 rng(seed * 1000003ULL + number);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
 
-    habit &h = data.habits[index];
-    update_log_for_today(h);          // grow log if needed
-    h.log[h.log_size - 1] = true;     // mark today as complete
-    recalculate_streak(h);
+    user new_user;
+    new_user.correct_username = loadgen_username(number);
+    new_user.correct_password = hash_password(LOADGEN_PREFIX + new_user.correct_username);
+    new_user.user_name = new_user.correct_username;
+    write_credentials(new_user);
 
-    // inform user that habit was checked off successfully 
-    write_line("Habit checked off successfully!");
+    // most users track a few habits, a long tail tracks many
+    std::geometric_distribution<int> extra_habits(0.35);
+    int habit_count = std::min(1 + extra_habits(rng), LOADGEN_HABIT_COUNT);
+    double adherence = 0.2 + 0.75 * uniform(rng);
+    const int targets[] = {7, 14, 21, 30, 60, 100, 365};
 
-    if (h.current_streak >= h.target)
-    {
-        write_line();
-        write_line("Congratulations! You've reached your target for the habit: " + h.name);
-        write_line("After celebrating, consider setting a new target.");
-        h.target = read_integer("Enter new target (number of days): ");
-    }
+    // saving over a user generated before takes their old habits off the leaderboard
+    app_data data;
+    data.board_batch = &batch;
 
-    if (h.current_streak == 365)
+    int today_index = get_today_index();
+    for (int i = 0; i < habit_count; i++)
     {
-        write_line();
-        write_line("Congratulations! You have completed this habit for one whole year!");
-        write_line("You have mastered displine!");
+        habit h;
+        h.name = LOADGEN_HABITS[i];
+        h.target = targets[rng() % 7];
+        h.category = (categories)(rng() % 5);
+        h.reminder_minute = uniform(rng) < 0.3 ? (int)(rng() % (24 * 60)) : -1;
+
+        // history lengths follow a heavy tail, most habits are young and a few are years old
+        h.log_size = std::min(1095, 1 + (int)(3.0 / std::pow(1.0 - uniform(rng), 1.0 / 1.2)));
+        h.log = new bool[h.log_size];
+        for (int day = 0; day < h.log_size; day++)
+        {
+            h.log[day] = uniform(rng) < adherence;
+        }
+        h.last_day_index = today_index;
+        h.current_streak = 0;
+
+        append_habit(data, h);
+        recalculate_streak(data, data.count - 1, today_index);
     }
-}
 
-// functions to update name of a habit
-void update_name(habit &data)
-{
-    data.name = read_string("Enter new habit name: ");
-    write_line("Habit name updated successfully!");
+    save_data(data, save_filename(new_user.correct_username));
+    cleanup(data);
 }
 
-// function to update target of a habit
-void update_target(habit &data)
+// this function writes a deterministic population of generated users on every core
+void generate_population(int user_count, unsigned long long seed)
 {
-    data.target = read_integer("Enter new target (number of days): ");
-    write_line("Habit target updated successfully!");
-}
+    int workers = std::max(1u, std::thread::hardware_concurrency());
+    leaderboard_batch batch;
 
-// function to update category of a habit
-void update_category(habit &data)
-{
-    write_line("Select new category:");
-    write_line("1. Health");
-    write_line("2. Fitness");
-    write_line("3. Study");
-    write_line("4. Hobby");
-    write_line("5. Other");
-    int category_choice = read_integer("Enter your choice: ", 1, 5);
-    data.category = (categories)(category_choice - 1);
-    write_line("Habit category updated successfully!");
+    std::vector<std::thread> generators;
+    for (int w = 0; w < workers; w++)
+    {
+        generators.emplace_back([=, &batch]()
+        {
+            for (int number = w; number < user_count; number += workers)
+                generate_user(number, seed, batch);
+        });
+    }
+    for (std::thread &generator : generators)
+    {
+        generator.join();
+    }
+    commit_board_changes(batch.changes);
+
+    write_line("Generated " + to_string(user_count) + " users.");
 }
 
-// this function updates the details of a habit in the application data
-void update_habit(app_data &data)
+// function to build synthetic sessions over the generated users, busy users are picked more often
+std::vector<session> synthetic_sessions(int session_count, unsigned long long seed)
 {
-    // Check if there are any habits to update
-    if (data.count == 0)
+    std::vector<string> users;
+    for (const auto &entry : read_manifest())
     {
-        write_line("No habits to update.");
-        return;
+        if (entry.first.rfind(LOADGEN_PREFIX, 0) == 0)
+        {
+            users.push_back(entry.first);
+        }
     }
 
-    // Display current habits
-    write_line("Current Habits: ");
-    for (int i = 0; i < data.count; i++)
+    std::vector<session> sessions;
+    if (users.empty())
     {
-        write_line(to_string(i + 1) + ". " + data.habits[i].name);
+        return sessions;
     }
 
-    // Get the index of the habit to update from the user
-    int index = read_integer("Enter the index of the habit to update: ") - 1;
-
-    // Validate the index
-    if (index < 0 || index >= data.count)
+    // cumulative weights for picking users by rank
+    std::vector<double> weights(users.size());
+    double total = 0;
+    for (size_t i = 0; i < users.size(); i++)
     {
-        write_line("Invalid index.");
-        return;
+        total += 1.0 / std::pow(i + 1, LOADGEN_USER_SKEW);
+        weights[i] = total;
     }
 
-    // Display update options to the user
-    write_line("Select an Option to Update:");
-    write_line("1. Name");  
-    write_line("2. Target");
-    write_line("3. Category");
-    write_line("4. All");
-    write_line("5. Back to Main Menu");
-
-    // Get the user's choice and perform the corresponding update
-    int choice = read_integer("Enter your choice: ", 1, 5);
-    while (choice != 5)
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, total);
+    for (int i = 0; i < session_count; i++)
     {
-        switch (choice)
+        session s;
+        s.user_name = users[std::upper_bound(weights.begin(), weights.end(), uniform(rng)) - weights.begin()];
+        s.steps.push_back({OP_LOGIN, 0});
+        int checks = rng() % 4;
+        for (int c = 0; c < checks; c++)
         {
-        case 1:
-            update_name(data.habits[index]);
-            break;
-        case 2:
-            update_target(data.habits[index]);
-            break;
-        case 3:
-            update_category(data.habits[index]);
-            break;
-        case 4:
-            update_name(data.habits[index]);
-            update_target(data.habits[index]);
-            update_category(data.habits[index]);
-            break;
-        default:
-            write_line("Invalid choice. Please try again.");
-            break;
+            s.steps.push_back({OP_CHECK, (int)(rng() % 16)});
+        }
+        if (rng() % 2 == 0)
+        {
+            s.steps.push_back({OP_REPORT, 0});
         }
-        choice = read_integer("Enter your choice: ", 1, 5);
+        s.steps.push_back({OP_EXIT, 0});
+        sessions.push_back(s);
     }
-    
-    // Confirm update to the user
-    write_line("Habits updated successfully!");
+    return sessions;
 }
 
-// this function pauses the program until the user presses Enter
-void pause_for_user()
+// function to read recorded sessions, one "user,op[,habit index]" line per step, a session ends at exit
+// only generated accounts are replayed so the load tool never writes to real users
+std::vector<session> recorded_sessions(const string &filename)
 {
-    write_line();
-    write_line("Press Enter to continue...");
-    read_line();
-}
-
-// function to save the habit data 
-void save_data(const app_data &data, const std::string &filename)
-{   
-    // open file
-    std::ofstream file(filename);
-
-    // if file does not open, inform user of error
+    std::vector<session> sessions;
+    std::ifstream file(filename);
     if (!file.is_open())
     {
-        write_line("Error opening file for saving data.");
-        return;
+        write_line("Error opening file for replay.");
+        return sessions;
     }
 
-    // seperate fields with commas and save to file
-    for (int i = 0; i < data.count; i++)
+    std::map<string, session> open_sessions;
+    string line;
+    long long skipped = 0;
+    while (std::getline(file, line))
     {
-        habit &h = data.habits[i];
-        file << h.name << "," << h.target << "," << h.current_streak << "," << h.category << "," << h.log_size << "," << h.last_day_index;
-        for (int j = 0; j < h.log_size; j++)
+        std::stringstream ss(line);
+        string user_name, op, index;
+        std::getline(ss, user_name, ',');
+        std::getline(ss, op, ',');
+        std::getline(ss, index, ',');
+
+        // the habit index is optional but must be a non-negative number
+        bool valid_index = index.size() <= 9 && std::all_of(index.begin(), index.end(), [](char c) { return c >= '0' && c <= '9'; });
+        session_step step = {OP_COUNT, index.empty() || !valid_index ? 0 : std::stoi(index)};
+        for (int o = 0; o < OP_COUNT; o++)
         {
-            file << "," << h.log[j];
+            if (op == session_op_to_string((session_op)o))
+                step.op = (session_op)o;
         }
-        // seperate habits by line 
-        file << "\n";
+        if (user_name.rfind(LOADGEN_PREFIX, 0) != 0 || step.op == OP_COUNT || !valid_index)
+        {
+            skipped++;
+            continue;
+        }
+
+        session &s = open_sessions[user_name];
+        s.user_name = user_name;
+        s.steps.push_back(step);
+        if (step.op == OP_EXIT)
+        {
+            sessions.push_back(s);
+            open_sessions.erase(user_name);
+        }
+    }
+
+    if (skipped > 0)
+    {
+        write_line("Skipped " + to_string(skipped) + " lines that were malformed or not for a generated " + LOADGEN_PREFIX + " account.");
     }
+    return sessions;
 }
 
-// this function reads and loads the data from a save file for a particular user
-void load_data(app_data &data, const std::string &filename)
+// this function replays sessions from several threads at a fixed total rate and reports latency per operation
+void replay_sessions(const std::vector<session> &sessions, int threads, double ops_per_second)
 {
-    // open file
-    std::ifstream file(filename);
-
-    // if there is an error opening the file, inform user
-    if (!file.is_open())
+    if (sessions.empty())
     {
-        write_line("Error opening file for loading data.");
+        write_line("No sessions to replay. Generate users with ./habit --generate first.");
         return;
     }
 
-    // read file line by line, each line representing one habit 
-    std::string line;
-    while (std::getline(file, line))
-    {
-        std::stringstream ss(line); // parse CSV format
-        habit h; // temporary habit to populate 
-        std::string token;
+    std::vector<std::mutex> user_locks(LOADGEN_USER_LOCKS);
+    std::vector<std::vector<long long>> latencies(threads * OP_COUNT);
+    std::atomic<int> next_session(0);
+    std::atomic<long long> failed_logins(0);
+    auto start = std::chrono::steady_clock::now();
 
-        // read fiels in order 
-        std::getline(ss, h.name, ',');
-        std::getline(ss, token, ','); h.target = std::stoi(token);
-        std::getline(ss, token, ','); h.current_streak = std::stoi(token);
-        std::getline(ss, token, ','); h.category = (categories)std::stoi(token);
-        std::getline(ss, token, ','); h.log_size = std::stoi(token);
-        std::getline(ss, token, ','); h.last_day_index = std::stoi(token);
+    auto replay = [&](int thread_number)
+    {
+        // each thread paces its own share of the total rate
+        std::chrono::duration<double> interval(ops_per_second > 0 ? threads / ops_per_second : 0);
+        auto next_op = std::chrono::steady_clock::now();
 
-        h.log = new bool[h.log_size];
-        for (int i = 0; i < h.log_size; i++)
+        int s;
+        while ((s = next_session++) < (int)sessions.size())
         {
-            std::getline(ss, token, ',');
-            h.log[i] = std::stoi(token);
+            const session &current = sessions[s];
+            std::mutex &user_lock = user_locks[std::hash<string>()(current.user_name) % LOADGEN_USER_LOCKS];
+            app_data data;
+            bool logged_in = false;
+            bool loaded = false;
+
+            for (const session_step &step : current.steps)
+            {
+                // latency runs from when the op was due, so time spent falling behind is counted
+                auto scheduled = std::chrono::steady_clock::now();
+                if (ops_per_second > 0)
+                {
+                    next_op += std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval);
+                    std::this_thread::sleep_until(next_op);
+                    scheduled = next_op;
+                }
+
+                // the user's lock is only held around their save file, never while pacing
+                bool end_session = false;
+                switch (step.op)
+                {
+                case OP_LOGIN:
+                {
+                    user stored;
+                    if (!read_credentials(current.user_name, stored) || hash_password(LOADGEN_PREFIX + current.user_name) != stored.correct_password)
+                    {
+                        failed_logins++;
+                        end_session = true;
+                        break;
+                    }
+                    logged_in = true;
+
+                    std::lock_guard<std::mutex> lock(user_lock);
+                    if (!loaded && std::filesystem::exists(save_filename(current.user_name)))
+                    {
+                        load_data(data, save_filename(current.user_name));
+                        loaded = true;
+                    }
+                    break;
+                }
+                case OP_CHECK:
+                    if (logged_in && data.count > 0)
+                        check_off_today(data, step.habit_index % data.count);
+                    break;
+                case OP_REPORT:
+                    if (logged_in)
+                        build_habit_report(data);
+                    break;
+                case OP_EXIT:
+                    if (loaded)
+                    {
+                        std::lock_guard<std::mutex> lock(user_lock);
+                        save_data(data, save_filename(current.user_name));
+                    }
+                    break;
+                default:
+                    break;
+                }
+                auto op_end = std::chrono::steady_clock::now();
+                latencies[thread_number * OP_COUNT + step.op].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(op_end - scheduled).count());
+
+                // a session that cannot log in stops here and never saves
+                if (end_session)
+                {
+                    break;
+                }
+            }
+            cleanup(data);
         }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++)
+    {
+        workers.emplace_back(replay, t);
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 
-        if (data.count < data.size)
+    // merge every thread's samples and report each operation
+    long long total_ops = 0;
+    write_line("Replayed " + to_string(sessions.size()) + " sessions on " + to_string(threads) + " threads in " + to_string(seconds) + " s");
+    for (int o = 0; o < OP_COUNT; o++)
+    {
+        std::vector<long long> samples;
+        for (int t = 0; t < threads; t++)
         {
-            data.habits[data.count] = h;
-            data.count++;
+            const std::vector<long long> &thread_samples = latencies[t * OP_COUNT + o];
+            samples.insert(samples.end(), thread_samples.begin(), thread_samples.end());
         }
-        else
+        if (samples.empty())
         {
-            habit* newArray = new habit[data.size * 2];
-            for (int i = 0; i < data.size; i++)
-                newArray[i] = data.habits[i];
-            delete[] data.habits;
-            data.habits = newArray;
-            data.size *= 2;
-            data.habits[data.count] = h;
-            data.count++;
+            continue;
         }
+
+        std::sort(samples.begin(), samples.end());
+        total_ops += samples.size();
+        auto percentile = [&](double p)
+        {
+            std::stringstream ss;
+            ss << std::fixed << std::setprecision(1) << samples[std::min(samples.size() - 1, (size_t)(p * samples.size()))] / 1000.0 << " us";
+            return ss.str();
+        };
+        write_line(session_op_to_string((session_op)o) + ": " + to_string(samples.size()) + " ops, " + to_string((long long)(samples.size() / seconds)) + " ops/s, p50 " + percentile(0.50) + ", p99 " + percentile(0.99) + ", p999 " + percentile(0.999));
+    }
+    write_line("Total: " + to_string((long long)(total_ops / seconds)) + " ops/s");
+    if (failed_logins > 0)
+    {
+        write_line(to_string(failed_logins.load()) + " logins did not match the generated password, those sessions were ended.");
     }
 }
 
-// function to handle application exit and data saving
-void exit_app(app_data &data, const string &active_user)
+// this function loads every generated user into memory and times the streak and report passes over them
+void bench_report(int passes)
 {
-    if (!active_user.empty())
+    std::vector<app_data> population;
+    long long habits = 0;
+    for (const auto &entry : read_manifest())
     {
-        save_data(data, save_filename(active_user));
-        write_line("Data saved. Exiting application.");
+        if (entry.first.rfind(LOADGEN_PREFIX, 0) != 0)
+        {
+            continue;
+        }
+        population.emplace_back();
+        load_data(population.back(), save_filename(entry.first));
+        habits += population.back().count;
+    }
+    if (habits == 0)
+    {
+        write_line("No habits to benchmark. Generate users with ./habit --generate first.");
+        return;
     }
-}
 
-void cleanup(app_data &data)
-{
-    for (int i = 0; i < data.count; i++)
+    // streak pass, the numeric part of every report
+    double progress = 0;
+    auto start = std::chrono::steady_clock::now();
+    int today_index = get_today_index();
+    for (int pass = 0; pass < passes; pass++)
     {
-        delete[] data.habits[i].log;
+        for (app_data &data : population)
+        {
+            for (int i = 0; i < data.count; i++)
+            {
+                recalculate_streak(data, i, today_index);
+                progress += std::min(1.0, (double)data.current_streaks[i] / data.targets[i]);
+            }
+        }
+    }
+    double streak_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (habits * passes);
+
+    // full report text
+    size_t report_bytes = 0;
+    start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; pass++)
+    {
+        for (app_data &data : population)
+        {
+            report_bytes += build_habit_report(data).size();
+        }
+    }
+    double report_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (habits * passes);
+
+    size_t table_bytes = habit_bytes(population.front());
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << population.size() << " users, " << habits << " habits, " << table_bytes << " table bytes per habit\n";
+    ss << "streak pass: " << streak_ns << " ns per habit\n";
+    ss << "report text: " << report_ns << " ns per habit\n";
+    write(ss.str());
+
+    // keep the sums live so the passes are not optimised away
+    if (progress < 0 || report_bytes == 0)
+    {
+        write_line();
+    }
+    for (app_data &data : population)
+    {
+        cleanup(data);
     }
-    delete[] data.habits;
-    delete[] data.users;
 }
 
 // this is the main function that runs the habit tracker application
-int main()
+int main(int argc, char *argv[])
 {
     app_data data; // create an instance of app_data to hold the application state
     std::filesystem::create_directories("users");
     std::filesystem::create_directories("saves");
 
+    // bulk import mode: ./habit --import checkins.csv
+    if (argc == 3 && string(argv[1]) == "--import")
+    {
+        import_history(argv[2]);
+        cleanup(data);
+        return 0;
+    }
+
+    // admin modes: ./habit --rebuild-index, ./habit --list-users
+    if (argc == 2 && string(argv[1]) == "--rebuild-index")
+    {
+        rebuild_manifest();
+        write_line("Manifest rebuilt.");
+        cleanup(data);
+        return 0;
+    }
+    if (argc == 2 && string(argv[1]) == "--list-users")
+    {
+        list_users();
+        cleanup(data);
+        return 0;
+    }
+
+    // load testing modes: ./habit --generate <users> [seed]
+    //                     ./habit --replay <threads> <ops per second, 0 for no limit> <sessions> [seed]
+    //                     ./habit --replay-file <threads> <ops per second, 0 for no limit> <sessions file>
+    //                     ./habit --bench-report [passes]
+    if ((argc == 3 || argc == 4) && string(argv[1]) == "--generate")
+    {
+        generate_population(std::stoi(argv[2]), argc == 4 ? std::stoull(argv[3]) : 1);
+        cleanup(data);
+        return 0;
+    }
+    if ((argc == 5 || argc == 6) && string(argv[1]) == "--replay")
+    {
+        replay_sessions(synthetic_sessions(std::stoi(argv[4]), argc == 6 ? std::stoull(argv[5]) : 1), std::max(1, std::stoi(argv[2])), std::stod(argv[3]));
+        cleanup(data);
+        return 0;
+    }
+    if ((argc == 2 || argc == 3) && string(argv[1]) == "--bench-report")
+    {
+        bench_report(argc == 3 ? std::stoi(argv[2]) : 10);
+        cleanup(data);
+        return 0;
+    }
+    if (argc == 5 && string(argv[1]) == "--replay-file")
+    {
+        replay_sessions(recorded_sessions(argv[4]), std::max(1, std::stoi(argv[2])), std::stod(argv[3]));
+        cleanup(data);
+        return 0;
+    }
+
+    // reminder mode: ./habit --reminders
+    if (argc == 2 && string(argv[1]) == "--reminders")
+    {
+        run_reminders();
+        cleanup(data);
+        return 0;
+    }
+
 
     // Display welcome message and application info
     write_line("Welcome to the Habit Tracker!");
@@ -733,10 +3115,11 @@ int main()
         write_line("3. Update Habit");
         write_line("4. Check Habit");
         write_line("5. View Habit Report");
-        write_line("6. Exit");
+        write_line("6. View Leaderboard");
+        write_line("7. Exit");
 
         // get user choice
-        choice = read_integer("Enter your choice: ", 1, 6);
+        choice = read_integer("Enter your choice: ", 1, 7);
 
         // handle user choice
         switch (choice)
@@ -758,7 +3141,11 @@ int main()
                 break;
             case 4:
                 write_line();
-                check_habit(data);
+                // save straight away so the reminder scheduler sees the check-in and cancels today's reminder
+                if (check_habit(data))
+                {
+                    save_data(data, save_filename(active_user));
+                }
                 pause_for_user();
                 break;
             case 5:
@@ -767,6 +3154,11 @@ int main()
                 pause_for_user();
                 break;
             case 6:
+                write_line();
+                leaderboard_report(data, active_user);
+                pause_for_user();
+                break;
+            case 7:
                 write_line();
                 break;
             default:
@@ -774,7 +3166,7 @@ int main()
                 write_line("Invalid choice. Please try again.");
                 break;
         }
-    } while (choice != 6);
+    } while (choice != 7);
 
     exit_app(data, active_user); // Save data and exit
     cleanup(data); // manage memory 